@@ -19,6 +19,7 @@
 //
 // that is until someone works out how to properly configure the BK chip !
 
+#include <assert.h>
 #include <string.h>
 
 #include "am_fix.h"
@@ -94,9 +95,6 @@ typedef struct
 // lookup table is hugely easier than writing code to do the same
 //
 
-#define LOOKUP_TABLE 1
-
-#if LOOKUP_TABLE
 static const t_gain_table gain_table[] =
 {
     {0x03BE, -7},   //  0 .. 3 5 3 6 ..   0dB  -4dB  0dB  -3dB ..  -7dB original
@@ -146,67 +144,32 @@ static const t_gain_table gain_table[] =
 };
 
 const uint8_t gain_table_size = ARRAY_SIZE(gain_table);
-#else
-
-t_gain_table gain_table[100] = {{0x03BE, -7}}; //original
-uint8_t gain_table_size = 0;
 
-void CreateTable()
+// gain_dB_index[dB + 93] is the highest gain table index (1..) whose gain does
+// not exceed dB, entries 1.. above are sorted by gain so this lets the AGC go
+// straight from an RSSI error to the table index instead of walking it
+//
+// must be regenerated if the gain table above changes
+static const uint8_t gain_dB_index[] =
 {
-typedef union  {
-    struct {
-        uint8_t pgaIdx:3;
-        uint8_t mixerIdx:2;
-        uint8_t lnaIdx:3;
-        uint8_t lnaSIdx:2;
-    };
-    uint16_t __raw;
-} GainData;
-
-    static const int8_t lna_short_dB[] = {-28, -24, -19,  0};   // corrected'ish
-    static const int8_t lna_dB[]       = {-24, -19, -14,  -9, -6, -4, -2, 0};
-    static const int8_t mixer_dB[]     = { -8,  -6,  -3,   0};
-    static const int8_t pga_dB[]       = {-33, -27, -21, -15, -9, -6, -3, 0};
-
-    unsigned i;
-    for (uint8_t lnaSIdx = 0; lnaSIdx < ARRAY_SIZE(lna_short_dB); lnaSIdx++) {
-        for (uint8_t lnaIdx = 0; lnaIdx < ARRAY_SIZE(lna_dB); lnaIdx++) {
-            for (uint8_t mixerIdx = 0; mixerIdx < ARRAY_SIZE(mixer_dB); mixerIdx++) {
-                for (uint8_t pgaIdx = 0; pgaIdx < ARRAY_SIZE(pga_dB); pgaIdx++) {
-                    int16_t db = lna_short_dB[lnaSIdx] + lna_dB[lnaIdx] + mixer_dB[mixerIdx] + pga_dB[pgaIdx];
-                    GainData gainData = {{
-                        pgaIdx,
-                        mixerIdx,
-                        lnaIdx,
-                        lnaSIdx,
-                    }};
-
-                    for (i = 1; i < ARRAY_SIZE(gain_table); i++) {
-                        t_gain_table * gain = &gain_table[i];
-                        if (db == gain->gain_dB)
-                            break;
-                        if (db > gain->gain_dB)
-                            continue;
-                        if (db < gain->gain_dB) {
-                            if(gain->gain_dB)
-                                memmove(gain + 1, gain, 100 - i);
-                            gain->gain_dB = db;
-                            gain->reg_val = gainData.__raw;
-                            break;
-                        }
-                        gain->gain_dB = db;
-                        gain->reg_val = gainData.__raw;
-                        break;
-                    }
-                }
-            }
-        }
-    }
+     1,  1,  2,  2,  2,  3,  4,  4,  5,  5,  5,  6,  7,  7,  8,  8,   // -93 .. -78dB
+     8,  9, 10, 10, 11, 11, 11, 12, 13, 13, 14, 14, 14, 15, 15, 15,   // -77 .. -62dB
+    16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 20, 20, 20, 21, 21,   // -61 .. -46dB
+    22, 22, 22, 23, 23, 24, 24, 24, 25, 25, 25, 26, 26, 27, 27, 28,   // -45 .. -30dB
+    28, 29, 29, 30, 30, 31, 32, 32, 33, 33, 34, 34, 35, 35, 35, 36,   // -29 .. -14dB
+    36, 37, 37, 37, 38, 38, 38, 39, 39, 40, 40, 41, 41, 42,           // -13 ..   0dB
+};
 
-    gain_table_size = i+1;
-}
-#endif
+static_assert(ARRAY_SIZE(gain_dB_index) == 94);
 
+static unsigned int gain_index_for_dB(const int16_t gain_dB)
+{
+    if (gain_dB <= -93)
+        return 1;
+    if (gain_dB >= 0)
+        return gain_table_size - 1u;
+    return gain_dB_index[gain_dB + 93];
+}
 
 #ifdef ENABLE_AM_FIX_SHOW_DATA
     // display update rate
@@ -221,8 +184,31 @@ unsigned int gain_table_index_prev[2] = {0, 0};
 int16_t prev_rssi[2] = {0, 0};
 // to help reduce gain hunting, peak hold count down tick
 unsigned int hold_counter[2] = {0, 0};
-// -89dBm, any higher and the AM demodulator starts to saturate/clip/distort
-const int16_t desired_rssi = (-89 + 160) * 2;
+
+typedef struct
+{
+    int16_t target_rssi;        // RSSI the loop regulates to, 0 = modulation not handled
+    uint8_t attack_dB;          // errors this big jump straight down ..
+    uint8_t attack_margin_dB;   // .. stopping this short of the target (noise/spike immunity)
+    uint8_t hysteresis_dB;      // how far under target before gain may come back up
+    uint8_t decay_hold_10ms;    // hold time before gain may come back up
+} t_agc_profile;
+
+static const t_agc_profile agc_profile[MODULATION_UKNOWN] =
+{
+    // -89dBm, any higher and the AM demodulator starts to saturate/clip/distort
+    [MODULATION_AM]  = {(-89 + 160) * 2, 10, 8, 6, 30},
+#ifdef ENABLE_SOFT_AGC
+    // FM has a limiter, only tame the signals strong enough to desense the front end
+    [MODULATION_FM]  = {(-70 + 160) * 2, 10, 8, 6, 50},
+    // SSB, slow decay so the gain doesn't pump between syllables
+    [MODULATION_USB] = {(-85 + 160) * 2,  6, 4, 6, 100},
+#ifdef ENABLE_BYP_RAW_DEMODULATORS
+    [MODULATION_BYP] = {(-70 + 160) * 2, 10, 8, 6, 50},
+    [MODULATION_RAW] = {(-85 + 160) * 2,  6, 4, 6, 100},
+#endif
+#endif
+};
 
 int8_t currentGainDiff;
 bool enabled = true;
@@ -232,9 +218,6 @@ void AM_fix_init(void)
     for (int i = 0; i < 2; i++) {
         gain_table_index[i] = 0;  // re-start with original QS setting
     }
-#if !LOOKUP_TABLE
-    CreateTable();
-#endif
 }
 
 void AM_fix_reset(const unsigned vfo)
@@ -258,11 +241,18 @@ void AM_fix_reset(const unsigned vfo)
 // won't/don't do it for itself, we're left to bodging it ourself by
 // playing with the RF front end gain setting
 //
-void AM_fix_10ms(const unsigned vfo)
+bool AM_fix_is_active(const ModulationMode_t modulation)
 {
-    if(!gSetting_AM_fix || !enabled || vfo > 1 )
+    return gSetting_AM_fix && modulation < MODULATION_UKNOWN && agc_profile[modulation].target_rssi != 0;
+}
+
+void AM_fix_10ms(const unsigned vfo, const ModulationMode_t modulation)
+{
+    if(!enabled || vfo > 1 || !AM_fix_is_active(modulation))
         return;
 
+    const t_agc_profile *profile = &agc_profile[modulation];
+
     if (gCurrentFunction != FUNCTION_FOREGROUND && !FUNCTION_IsRx()) {
 #ifdef ENABLE_AM_FIX_SHOW_DATA
         counter = display_update_rate;  // queue up a display update as soon as we switch to RX mode
@@ -279,9 +269,11 @@ void AM_fix_10ms(const unsigned vfo)
     }
 #endif
 
-    static uint32_t lastFreq[2];
-    if(gEeprom.VfoInfo[vfo].pRX->Frequency != lastFreq[vfo]) {
-        lastFreq[vfo] = gEeprom.VfoInfo[vfo].pRX->Frequency;
+    static uint32_t         lastFreq[2];
+    static ModulationMode_t lastModulation[2];
+    if(gEeprom.VfoInfo[vfo].pRX->Frequency != lastFreq[vfo] || modulation != lastModulation[vfo]) {
+        lastFreq[vfo]       = gEeprom.VfoInfo[vfo].pRX->Frequency;
+        lastModulation[vfo] = modulation;
         AM_fix_reset(vfo);
     }
 
@@ -315,43 +307,37 @@ void AM_fix_10ms(const unsigned vfo)
         hold_counter[vfo]--;
 
     // dB difference between actual and desired RSSI level
-    int16_t diff_dB = (rssi - desired_rssi) / 2;
+    int16_t diff_dB = (rssi - profile->target_rssi) / 2;
 
     if (diff_dB > 0) {  // decrease gain
-        unsigned int index = gain_table_index[vfo];   // current position we're at
-
-        if (diff_dB >= 10) {    // jump immediately to a new gain setting
-            // this greatly speeds up initial gain reduction (but reduces noise/spike immunity)
+        const unsigned int current = gain_table_index[vfo];   // current position we're at
+        int16_t desired_gain_dB    = (int16_t)gain_table[current].gain_dB - diff_dB;
 
-            const int16_t desired_gain_dB = (int16_t)gain_table[index].gain_dB - diff_dB + 8; // get no closer than 8dB (bit of noise/spike immunity)
-
-            // scan the table to see what index to jump straight too
-            while (index > 1)
-                if (gain_table[--index].gain_dB <= desired_gain_dB)
-                    break;
-        }
-        else
-        {   // incrementally reduce the gain .. taking it slow improves noise/spike immunity
-            if (index > 1)
-                index--;     // slow step-by-step gain reduction
-        }
+        if (diff_dB >= profile->attack_dB)      // big error, don't get too close (bit of noise/spike immunity)
+            desired_gain_dB += profile->attack_margin_dB;
 
+        // jump straight to the index giving the wanted reduction, always at least one step down
+        unsigned int index = gain_index_for_dB(desired_gain_dB);
+        if (current > 1)
+            index = MIN(index, current - 1u);
         index = MAX(1u, index);
 
-        if (gain_table_index[vfo] != index)
+        if (current != index)
         {
             gain_table_index[vfo] = index;
-            hold_counter[vfo] = 30;       // 300ms hold
+            hold_counter[vfo] = profile->decay_hold_10ms;
         }
     }
 
-    if (diff_dB >= -6)                    // 6dB hysterisis (help reduce gain hunting)
-        hold_counter[vfo] = 30;           // 300ms hold
+    if (diff_dB >= -profile->hysteresis_dB)     // hysterisis (help reduce gain hunting)
+        hold_counter[vfo] = profile->decay_hold_10ms;
 
     if (hold_counter[vfo] == 0)
     {   // hold has been released, we're free to increase gain
-        const unsigned int index = gain_table_index[vfo] + 1;                 // move up to next gain index
-        gain_table_index[vfo] = MIN(index, gain_table_size - 1u);
+        // go up by what keeps us just inside the hysterisis window, at least one step
+        const unsigned int current = gain_table_index[vfo];
+        const unsigned int index   = gain_index_for_dB((int16_t)gain_table[current].gain_dB - diff_dB - profile->hysteresis_dB);
+        gain_table_index[vfo] = MIN(MAX(index, current + 1u), gain_table_size - 1u);
     }
 
 
@@ -20,10 +20,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "radio.h"
+
 #ifdef ENABLE_AM_FIX
     void AM_fix_init(void);
     void AM_fix_reset(const unsigned vfo);
-    void AM_fix_10ms(const unsigned vfo);
+    void AM_fix_10ms(const unsigned vfo, const ModulationMode_t modulation);
+    // true when the software gain loop regulates this modulation
+    bool AM_fix_is_active(const ModulationMode_t modulation);
     #ifdef ENABLE_AM_FIX_SHOW_DATA
         void AM_fix_print_data(const unsigned vfo, char *s);
     #endif
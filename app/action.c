@@ -48,6 +48,7 @@
 
 #if defined(ENABLE_FMRADIO)
 static void ACTION_Scan_FM(bool bRestart);
+static void ACTION_FmBackgroundScan(void);
 #endif
 
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
@@ -86,6 +87,12 @@ void (*action_opt_table[])(void) = {
     [ACTION_OPT_FM] = &FUNCTION_NOP,
 #endif
 
+#ifdef ENABLE_FMRADIO
+    [ACTION_OPT_FM_SCAN] = &ACTION_FmBackgroundScan,
+#else
+    [ACTION_OPT_FM_SCAN] = &FUNCTION_NOP,
+#endif
+
 #ifdef ENABLE_ALARM
     [ACTION_OPT_ALARM] = &ACTION_Alarm,
 #else
@@ -384,6 +391,19 @@ void ACTION_FM(void)
     }
 }
 
+static void ACTION_FmBackgroundScan(void)
+{
+    if (gFmRadioMode) {
+        gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+        return;
+    }
+
+    if (FM_IsBackgroundScanning())
+        FM_StopBackgroundScan(false);
+    else
+        FM_StartBackgroundScan();
+}
+
 static void ACTION_Scan_FM(bool bRestart)
 {
     if (FUNCTION_IsRx())
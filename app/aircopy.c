@@ -20,11 +20,14 @@
 //  #include "ARMCM0.h"
 //#endif
 
+#include <string.h>
+
 #include "app/aircopy.h"
 #include "audio.h"
 #include "driver/bk4819.h"
 #include "driver/crc.h"
 #include "driver/eeprom.h"
+#include "driver/system.h"
 #include "frequencies.h"
 #include "misc.h"
 #include "radio.h"
@@ -38,12 +41,44 @@
 
 static const uint16_t Obfuscation[8] = { 0x6C16, 0xE614, 0x912E, 0x400D, 0x3521, 0x40D5, 0x0313, 0x80E9 };
 
+// acknowledged protocol frame, in words:
+//   0       0xABCD
+//   1       0xA000 | type << 8 | block
+//   2-61    block data, a block bitmap in poll and status frames, the
+//           CRCs of the 60 blocks from block on in a CRC frame
+//   62      CRC of words 1 to 61
+//   63      0xDCBA
+// words 1 to 62 are obfuscated as in the original frame
+enum {
+    ACK_DATA = 0,
+    ACK_POLL,         // sender to receiver at the end of a pass, with the blocks it counts as done
+    ACK_STATUS,       // the reply, which blocks the receiver holds
+    ACK_CRC_REQUEST,  // delta mode, sender to receiver before the first pass
+    ACK_CRCS          // the reply
+};
+
+#define ACK_TAG             0xA000   // above any original frame offset
+#define ACK_GAP_10ms        30       // between frames, the receiver writes and re-arms
+#define ACK_REPLY_10ms      300      // wait for the reply, a CRC frame takes the receiver ~1s to read out
+#define ACK_REPLY_DELAY_ms  100      // for the sender to turn around to RX
+#define ACK_POLL_RETRIES    5
+
 AIRCOPY_State_t gAircopyState;
 uint16_t gAirCopyBlockNumber;
 uint16_t gErrorsDuringAirCopy;
 uint8_t gAirCopyIsSendMode;
+bool gAirCopyAck;
+bool gAirCopyDelta;
+uint8_t gAirCopyBlocks[AIRCOPY_ACK_BLOCKS / 8];
 
-uint16_t g_FSK_Buffer[36];
+uint16_t g_FSK_Buffer[AIRCOPY_ACK_FRAME_WORDS];
+
+static uint8_t  gAckNextBlock;
+static uint8_t  gAckCrcNext;   // delta mode, first block whose CRC the sender still has to ask for
+static uint16_t gAckCountdown;
+static uint8_t  gAckPollRetries;
+static bool     gAckAwaitingStatus;
+static bool     gAckLinger;    // receiver done, still answering polls
 
 static void AIRCOPY_clear()
 {
@@ -51,11 +86,243 @@ static void AIRCOPY_clear()
     {
         crc[i] = 0;
     }
+
+    memset(gAirCopyBlocks, 0, sizeof(gAirCopyBlocks));
+    gAckNextBlock = 0;
+    gAckCrcNext = gAirCopyDelta ? 0 : AIRCOPY_ACK_BLOCKS;
+    gAckCountdown = 1;
+    gAckPollRetries = 0;
+    gAckAwaitingStatus = false;
+    gAckLinger = false;
+
     #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
         getScreenShot(true);
     #endif
 }
 
+static void AIRCOPY_Complete(AIRCOPY_State_t State)
+{
+    gAircopyState = State;
+    #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
+        getScreenShot(false);
+    #endif
+}
+
+static uint8_t AIRCOPY_FrameWords(void)
+{
+    return gAirCopyAck ? AIRCOPY_ACK_FRAME_WORDS : AIRCOPY_FRAME_WORDS;
+}
+
+static void AIRCOPY_Obfuscate(void)
+{
+    for (unsigned int i = 0; i < AIRCOPY_FrameWords() - 2u; i++) {
+        g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+    }
+}
+
+static void AIRCOPY_SendFrame(void)
+{
+    const uint8_t Words = AIRCOPY_FrameWords();
+
+    g_FSK_Buffer[0] = 0xABCD;
+    g_FSK_Buffer[Words - 1] = 0xDCBA;
+
+    AIRCOPY_Obfuscate();
+
+    RADIO_SetTxParameters();
+
+    BK4819_SendFSKData(g_FSK_Buffer, Words);
+    BK4819_SetupPowerAmplifier(0, 0);
+    BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+}
+
+static void AIRCOPY_BackToRx(void)
+{
+    // the TX setup dropped RX_ENABLE and tuned to the TX frequency and filter,
+    // put the RX path back the way boot left it before listening again
+    RADIO_SetupRegisters(true);
+    BK4819_SetupAircopy(AIRCOPY_FrameWords() * 2);
+    BK4819_PrepareFSKReceive();
+}
+
+static bool AIRCOPY_HasBlock(uint8_t Block)
+{
+    return (gAirCopyBlocks[Block / 8] >> (Block % 8)) & 1u;
+}
+
+static uint16_t AIRCOPY_CountBlocks(void)
+{
+    uint16_t Count = 0;
+    for (uint8_t i = 0; i < AIRCOPY_ACK_BLOCKS; i++) {
+        Count += AIRCOPY_HasBlock(i);
+    }
+    return Count;
+}
+
+static void AIRCOPY_SetBlocks(const void *pBlocks)
+{
+    const uint8_t *pBits = pBlocks;
+    for (unsigned int i = 0; i < sizeof(gAirCopyBlocks); i++) {
+        gAirCopyBlocks[i] |= pBits[i];
+    }
+    gAirCopyBlockNumber = AIRCOPY_CountBlocks();
+}
+
+static uint16_t AIRCOPY_BlockCRC(uint8_t Block)
+{
+    uint8_t Data[AIRCOPY_ACK_BLOCK_SIZE];
+    EEPROM_ReadBuffer(Block * AIRCOPY_ACK_BLOCK_SIZE, Data, sizeof(Data));
+    return CRC_Calculate(Data, sizeof(Data));
+}
+
+static void AIRCOPY_AckSend(uint8_t Type, uint8_t Block)
+{
+    memset(&g_FSK_Buffer[2], 0, AIRCOPY_ACK_BLOCK_SIZE);
+
+    if (Type == ACK_DATA) {
+        EEPROM_ReadBuffer(Block * AIRCOPY_ACK_BLOCK_SIZE, &g_FSK_Buffer[2], AIRCOPY_ACK_BLOCK_SIZE);
+    } else if (Type == ACK_POLL || Type == ACK_STATUS) {
+        memcpy(&g_FSK_Buffer[2], gAirCopyBlocks, sizeof(gAirCopyBlocks));
+    } else if (Type == ACK_CRCS) {
+        for (unsigned int i = 0; i < AIRCOPY_ACK_BLOCK_SIZE / 2 && Block + i < AIRCOPY_ACK_BLOCKS; i++) {
+            g_FSK_Buffer[2 + i] = AIRCOPY_BlockCRC(Block + i);
+        }
+    }
+
+    g_FSK_Buffer[1] = ACK_TAG | Type << 8 | Block;
+    g_FSK_Buffer[62] = CRC_Calculate(&g_FSK_Buffer[1], 2 + AIRCOPY_ACK_BLOCK_SIZE);
+
+    AIRCOPY_SendFrame();
+}
+
+static bool AIRCOPY_AckSendMessage(void)
+{
+    if (--gAckCountdown) {
+        return 1;
+    }
+
+    if (gAckAwaitingStatus) {
+        // no status frame came back, poll again
+        gErrorsDuringAirCopy++;
+        if (++gAckPollRetries > ACK_POLL_RETRIES) {
+            AIRCOPY_Complete(AIRCOPY_FAILED);
+            return 0;
+        }
+    } else if (gAckCrcNext >= AIRCOPY_ACK_BLOCKS) {
+        while (gAckNextBlock < AIRCOPY_ACK_BLOCKS && AIRCOPY_HasBlock(gAckNextBlock)) {
+            gAckNextBlock++;
+        }
+
+        if (gAckNextBlock < AIRCOPY_ACK_BLOCKS) {
+            AIRCOPY_AckSend(ACK_DATA, gAckNextBlock++);
+            gAckCountdown = ACK_GAP_10ms;
+            return 0;
+        }
+    }
+
+    if (gAckCrcNext < AIRCOPY_ACK_BLOCKS) {
+        // delta mode, find out what the receiver already holds first
+        AIRCOPY_AckSend(ACK_CRC_REQUEST, gAckCrcNext);
+    } else {
+        // end of the pass, ask the receiver which blocks it still misses
+        AIRCOPY_AckSend(ACK_POLL, 0);
+    }
+
+    gFSKWriteIndex = 0;
+    AIRCOPY_BackToRx();
+
+    gAckAwaitingStatus = true;
+    gAckCountdown = ACK_REPLY_10ms;
+
+    return 0;
+}
+
+static void AIRCOPY_AckStorePacket(void)
+{
+    const uint8_t Type = (g_FSK_Buffer[1] >> 8) & 0x0F;
+    const uint8_t Block = g_FSK_Buffer[1] & 0xFF;
+
+    if ((g_FSK_Buffer[1] & 0xF000) != ACK_TAG || Block >= AIRCOPY_ACK_BLOCKS ||
+        g_FSK_Buffer[62] != CRC_Calculate(&g_FSK_Buffer[1], 2 + AIRCOPY_ACK_BLOCK_SIZE)) {
+        gErrorsDuringAirCopy++;
+        return;
+    }
+
+    if (gAirCopyIsSendMode) {
+        if (!gAckAwaitingStatus) {
+            return;
+        }
+
+        if (Type == ACK_CRCS && Block == gAckCrcNext) {
+            // the blocks that already match count as sent
+            for (unsigned int i = 0; i < AIRCOPY_ACK_BLOCK_SIZE / 2 && Block + i < AIRCOPY_ACK_BLOCKS; i++) {
+                if (g_FSK_Buffer[2 + i] == AIRCOPY_BlockCRC(Block + i)) {
+                    gAirCopyBlocks[(Block + i) / 8] |= 1u << ((Block + i) % 8);
+                }
+            }
+            gAirCopyBlockNumber = AIRCOPY_CountBlocks();
+            gAckCrcNext = Block + AIRCOPY_ACK_BLOCK_SIZE / 2;
+        } else if (Type == ACK_STATUS && gAckCrcNext >= AIRCOPY_ACK_BLOCKS) {
+            AIRCOPY_SetBlocks(&g_FSK_Buffer[2]);
+
+            // the blocks still missing go out again in the next pass
+            gErrorsDuringAirCopy += AIRCOPY_ACK_BLOCKS - gAirCopyBlockNumber;
+        } else {
+            return;
+        }
+
+        gAckAwaitingStatus = false;
+        gAckPollRetries = 0;
+        gAckNextBlock = 0;
+        gAckCountdown = ACK_GAP_10ms;
+
+        if (gAirCopyBlockNumber == AIRCOPY_ACK_BLOCKS) {
+            AIRCOPY_Complete(AIRCOPY_COMPLETE);
+        }
+        return;
+    }
+
+    if (Type == ACK_DATA && !AIRCOPY_HasBlock(Block)) {
+        uint16_t Offset = Block * AIRCOPY_ACK_BLOCK_SIZE;
+        const uint16_t *pData = &g_FSK_Buffer[2];
+        for (unsigned int i = 0; i < AIRCOPY_ACK_BLOCK_SIZE / 8; i++) {
+            EEPROM_WriteBuffer(Offset, pData);
+            pData += 4;
+            Offset += 8;
+        }
+
+        gAirCopyBlocks[Block / 8] |= 1u << (Block % 8);
+        gAirCopyBlockNumber++;
+    } else if (Type == ACK_POLL) {
+        // in delta mode the poll also carries the blocks that matched
+        AIRCOPY_SetBlocks(&g_FSK_Buffer[2]);
+
+        SYSTEM_DelayMs(ACK_REPLY_DELAY_ms);
+        AIRCOPY_AckSend(ACK_STATUS, 0);
+        AIRCOPY_BackToRx();
+
+        if (gAirCopyBlockNumber == AIRCOPY_ACK_BLOCKS && gAircopyState == AIRCOPY_TRANSFER) {
+            gAckLinger = true;
+            AIRCOPY_Complete(AIRCOPY_COMPLETE);
+        }
+    } else if (Type == ACK_CRC_REQUEST) {
+        SYSTEM_DelayMs(ACK_REPLY_DELAY_ms);
+        AIRCOPY_AckSend(ACK_CRCS, Block);
+        AIRCOPY_BackToRx();
+    }
+}
+
+bool AIRCOPY_IsReceiving(void)
+{
+    if (gAirCopyIsSendMode) {
+        return gAircopyState == AIRCOPY_TRANSFER && gAckAwaitingStatus;
+    }
+
+    // a complete acknowledged receiver keeps answering polls until EXIT,
+    // the sender polls again if the last status frame got lost
+    return gAircopyState == AIRCOPY_TRANSFER || gAckLinger;
+}
+
 bool AIRCOPY_SendMessage(void)
 {
     static uint8_t gAircopySendCountdown = 1;
@@ -64,6 +331,10 @@ bool AIRCOPY_SendMessage(void)
         return 1;
     }
 
+    if (gAirCopyAck) {
+        return AIRCOPY_AckSendMessage();
+    }
+
     if (--gAircopySendCountdown) {
         return 1;
     }
@@ -74,23 +345,12 @@ bool AIRCOPY_SendMessage(void)
 
     g_FSK_Buffer[34] = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
 
-    for (unsigned int i = 0; i < 34; i++) {
-        g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
-    }
-
-    if (++gAirCopyBlockNumber >= 0x78) {
-        gAircopyState = AIRCOPY_COMPLETE;
-        #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
-            getScreenShot(false);
-        #endif
+    if (++gAirCopyBlockNumber >= AIRCOPY_BLOCKS) {
+        AIRCOPY_Complete(AIRCOPY_COMPLETE);
         //NVIC_SystemReset();
     }
 
-    RADIO_SetTxParameters();
-
-    BK4819_SendFSKData(g_FSK_Buffer);
-    BK4819_SetupPowerAmplifier(0, 0);
-    BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+    AIRCOPY_SendFrame();
 
     gAircopySendCountdown = 30;
 
@@ -99,7 +359,9 @@ bool AIRCOPY_SendMessage(void)
 
 void AIRCOPY_StorePacket(void)
 {
-    if (gFSKWriteIndex < 36) {
+    const uint8_t Words = AIRCOPY_FrameWords();
+
+    if (gFSKWriteIndex < Words) {
         return;
     }
 
@@ -110,13 +372,16 @@ void AIRCOPY_StorePacket(void)
 
     // Doc says bit 4 should be 1 = CRC OK, 0 = CRC FAIL, but original firmware checks for FAIL.
 
-    if ((Status & 0x0010U) != 0 || g_FSK_Buffer[0] != 0xABCD || g_FSK_Buffer[35] != 0xDCBA) {
+    if ((Status & 0x0010U) != 0 || g_FSK_Buffer[0] != 0xABCD || g_FSK_Buffer[Words - 1] != 0xDCBA) {
         gErrorsDuringAirCopy++;
         return;
     }
 
-    for (unsigned int i = 0; i < 34; i++) {
-        g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+    AIRCOPY_Obfuscate();
+
+    if (gAirCopyAck) {
+        AIRCOPY_AckStorePacket();
+        return;
     }
 
     uint16_t CRC = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
@@ -140,10 +405,7 @@ void AIRCOPY_StorePacket(void)
     }
 
     if (Offset == 0x1E00) {
-        gAircopyState = AIRCOPY_COMPLETE;
-        #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
-            getScreenShot(false);
-        #endif
+        AIRCOPY_Complete(AIRCOPY_COMPLETE);
     }
 
     gAirCopyBlockNumber++;
@@ -189,7 +451,7 @@ static void AIRCOPY_Key_DIGITS(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
         RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
         gCurrentVfo = gRxVfo;
         RADIO_SetupRegisters(true);
-        BK4819_SetupAircopy();
+        BK4819_SetupAircopy(AIRCOPY_FrameWords() * 2);
         BK4819_ResetFSK();
         return;
     }
@@ -234,9 +496,6 @@ static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld)
     gAirCopyBlockNumber = 0;
     gInputBoxIndex = 0;
     gAirCopyIsSendMode = 1;
-    g_FSK_Buffer[0] = 0xABCD;
-    g_FSK_Buffer[1] = 0;
-    g_FSK_Buffer[35] = 0xDCBA;
 
     AIRCOPY_clear();
 
@@ -245,6 +504,28 @@ static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld)
     gAircopyState = AIRCOPY_TRANSFER;
 }
 
+static void AIRCOPY_Key_STAR(bool bKeyPressed, bool bKeyHeld)
+{
+    // switching mid-copy would change the frame length under the block counters
+    if (bKeyHeld || !bKeyPressed || gInputBoxIndex != 0 || gAircopyState != AIRCOPY_READY) {
+        return;
+    }
+
+    // original, acknowledged, delta, both radios have to be in the same mode
+    // for the frame lengths to match
+    if (gAirCopyDelta) {
+        gAirCopyAck = gAirCopyDelta = false;
+    } else if (gAirCopyAck) {
+        gAirCopyDelta = true;
+    } else {
+        gAirCopyAck = true;
+    }
+    gAckLinger = false;
+    BK4819_SetupAircopy(AIRCOPY_FrameWords() * 2);
+
+    gRequestDisplayScreen = DISPLAY_AIRCOPY;
+}
+
 void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 {
     switch (Key) {
@@ -266,6 +547,9 @@ void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
     case KEY_EXIT:
         AIRCOPY_Key_EXIT(bKeyPressed, bKeyHeld);
         break;
+    case KEY_STAR:
+        AIRCOPY_Key_STAR(bKeyPressed, bKeyHeld);
+        break;
     default:
         break;
     }
@@ -25,18 +25,38 @@ enum AIRCOPY_State_t
 {
     AIRCOPY_READY = 0,
     AIRCOPY_TRANSFER,
-    AIRCOPY_COMPLETE
+    AIRCOPY_COMPLETE,
+    AIRCOPY_FAILED      // the acknowledged sender gave up polling
 };
 
 typedef enum AIRCOPY_State_t AIRCOPY_State_t;
 
+// original protocol: 0x78 blocks of 64 bytes sent once, unacknowledged
+#define AIRCOPY_FRAME_WORDS      36
+#define AIRCOPY_BLOCKS           0x78
+
+// acknowledged protocol (* toggles it): 64 blocks of 120 bytes, after each
+// pass the sender polls the receiver for the blocks it holds and only
+// sends the missing ones again
+#define AIRCOPY_ACK_FRAME_WORDS  64
+#define AIRCOPY_ACK_BLOCKS       64
+#define AIRCOPY_ACK_BLOCK_SIZE   120
+
+// delta mode (* again) runs the acknowledged protocol but first asks the
+// receiver for the CRC of each of its blocks, the ones that already match
+// are never sent
+
 extern AIRCOPY_State_t gAircopyState;
 extern uint16_t        gAirCopyBlockNumber;
 extern uint16_t        gErrorsDuringAirCopy;
 extern uint8_t         gAirCopyIsSendMode;
+extern bool            gAirCopyAck;
+extern bool            gAirCopyDelta;
+extern uint8_t         gAirCopyBlocks[AIRCOPY_ACK_BLOCKS / 8];   // received, or acknowledged when sending
 
-extern uint16_t        g_FSK_Buffer[36];
+extern uint16_t        g_FSK_Buffer[AIRCOPY_ACK_FRAME_WORDS];
 
+bool AIRCOPY_IsReceiving(void);
 bool AIRCOPY_SendMessage(void);
 void AIRCOPY_StorePacket(void);
 void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
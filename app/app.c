@@ -59,6 +59,7 @@
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
+#include "driver/systick.h"
 #include "dtmf.h"
 #include "external/printf/printf.h"
 #include "frequencies.h"
@@ -67,6 +68,10 @@
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
+#ifdef ENABLE_EXTRA_UART_CMD
+    #include "telemetry.h"
+#endif
+#include "trace.h"
 
 #if defined(ENABLE_OVERLAY)
     #include "sram-overlay.h"
@@ -654,15 +659,36 @@ static void DualwatchAlternate(void)
     #endif
 }
 
+// the states where an interrupt event seen on the next 10ms slice is late,
+// RX idle keeps to the slice and spares the bus the REG_0C reads
+static bool RadioInterruptsUrgent(void)
+{
+    if (gCurrentFunction == FUNCTION_TRANSMIT || gCurrentFunction == FUNCTION_POWER_SAVE)
+        return false;
+
+#ifdef ENABLE_AIRCOPY
+    if (gScreenToDisplay == DISPLAY_AIRCOPY)
+        return true;    // FSK reception, a late read overruns the FIFO
+#endif
+
+    if (gScanStateDir != SCAN_OFF)
+        return true;    // squelch found, the scan stops on the signal
+
+    // a signal is open, DTMF tones, CSS and the squelch closing
+    return gCurrentFunction == FUNCTION_INCOMING || gCurrentFunction == FUNCTION_MONITOR;
+}
+
 static void CheckRadioInterrupts(void)
 {
     if (SCANNER_IsScanning())
         return;
 
-    while (BK4819_ReadRegister(BK4819_REG_0C) & 1u) { // BK chip interrupt request
-        // clear interrupts
-        BK4819_WriteRegister(BK4819_REG_02, 0);
-        // fetch interrupt status bits
+    while (1) {
+        uint16_t Status;
+
+        BK4819_IRQ_Poll();
+        if (!BK4819_IRQ_Pop(&Status))
+            break;
 
         union {
             struct {
@@ -686,7 +712,9 @@ static void CheckRadioInterrupts(void)
             uint16_t __raw;
         } interrupts;
 
-        interrupts.__raw = BK4819_ReadRegister(BK4819_REG_02);
+        interrupts.__raw = Status;
+
+        TRACE(TRACE_BK4819_IRQ, Status);
 
         // 0 = no phase shift
         // 1 = 120deg phase shift
@@ -698,37 +726,8 @@ static void CheckRadioInterrupts(void)
 
         if (interrupts.dtmf5ToneFound) {    
             const char c = DTMF_GetCharacter(BK4819_GetDTMF_5TONE_Code()); // save the RX'ed DTMF character
-            if (c != 0xff) {
-                if (gCurrentFunction != FUNCTION_TRANSMIT) {
-                    if (gSetting_live_DTMF_decoder) {
-                        size_t len = strlen(gDTMF_RX_live);
-                        if (len >= sizeof(gDTMF_RX_live) - 1) { // make room
-                            memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
-                            len--;
-                        }
-                        gDTMF_RX_live[len++]  = c;
-                        gDTMF_RX_live[len]    = 0;
-                        gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  // time till we delete it
-                        gUpdateDisplay        = true;
-                    }
-
-#ifdef ENABLE_DTMF_CALLING
-                    if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
-                        if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) { // make room
-                            memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
-                            gDTMF_RX_index--;
-                        }
-                        gDTMF_RX[gDTMF_RX_index++] = c;
-                        gDTMF_RX[gDTMF_RX_index]   = 0;
-                        gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;  // time till we delete it
-                        gDTMF_RX_pending           = true;
-                        
-                        SYSTEM_DelayMs(3);//fix DTMF not reply@Yurisu
-                        DTMF_HandleRequest();
-                    }
-#endif
-                }
-            }
+            if (c != 0xff && gCurrentFunction != FUNCTION_TRANSMIT)
+                DTMF_RX_Push(c);
         }
 
         if (interrupts.cssTailFound)
@@ -778,6 +777,7 @@ static void CheckRadioInterrupts(void)
 
         if (interrupts.sqlLost) {
             g_SquelchLost = true;
+            TRACE(TRACE_SQUELCH, 1);
             BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, true);
             #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER
                 gRxTimerCountdown_500ms = 7200;
@@ -786,14 +786,14 @@ static void CheckRadioInterrupts(void)
 
         if (interrupts.sqlFound) {
             g_SquelchLost = false;
+            TRACE(TRACE_SQUELCH, 0);
             BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, false);
         }
 
 #ifdef ENABLE_AIRCOPY
         if (interrupts.fskFifoAlmostFull &&
             gScreenToDisplay == DISPLAY_AIRCOPY &&
-            gAircopyState == AIRCOPY_TRANSFER &&
-            gAirCopyIsSendMode == 0)
+            AIRCOPY_IsReceiving())
         {
             for (unsigned int i = 0; i < 4; i++) {
                 g_FSK_Buffer[gFSKWriteIndex++] = BK4819_ReadRegister(BK4819_REG_5F);
@@ -807,6 +807,8 @@ static void CheckRadioInterrupts(void)
 
 void APP_EndTransmission(void)
 {
+    TRACE(TRACE_TX_STOP, 0);
+
     // back to RX mode
     RADIO_SendEndOfTransmission();
 
@@ -894,6 +896,13 @@ static void HandleVox(void)
 
 void APP_Update(void)
 {
+#ifdef ENABLE_REG_TRACE
+    TRACE_Stream();
+#endif
+#ifdef ENABLE_EXTRA_UART_CMD
+    TELEMETRY_Send();
+#endif
+
 #ifdef ENABLE_VOICE
     if (gFlagPlayQueuedVoice) {
             AUDIO_PlayQueuedVoice();
@@ -973,7 +982,7 @@ void APP_Update(void)
                 gPttIsPressed = false;
                 gPttOnePushCounter = 0;
                 gPttWasReleased = true;
-                //if (gKeyReading1 != KEY_INVALID)
+                //if (gKeyboard.Reading1 != KEY_INVALID)
                 //  gPttWasReleased = true;
             }
             #if defined(ENABLE_FEAT_F4HWN_CTR) || defined(ENABLE_FEAT_F4HWN_INV)
@@ -994,6 +1003,17 @@ void APP_Update(void)
     if (gReducedService)
         return;
 
+    if (RadioInterruptsUrgent()) {
+        // pick these events up every 2.5ms rather than on the 10ms slice
+        static uint8_t PrevQuarter;
+        const uint8_t  Quarter = SYSTICK_GetTickQuarter();
+
+        if (Quarter != PrevQuarter) {
+            PrevQuarter = Quarter;
+            CheckRadioInterrupts();
+        }
+    }
+
     if (gCurrentFunction != FUNCTION_TRANSMIT)
         HandleFunction();
 
@@ -1127,18 +1147,7 @@ void APP_Update(void)
         {   // dual watch mode off or scanning or rssi update request
             // go back to sleep
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP
-            if(gWakeUp)
-            {
-                gPowerSave_10ms = gEeprom.BATTERY_SAVE * 200; // deep sleep now indexed on BatSav
-            }
-            else
-            {
-                gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-            }
-#else
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-#endif
+            gPowerSave_10ms = FUNCTION_PowerSaveSleep_10ms();
             gRxIdleMode     = true;
             goToSleep = false;
 
@@ -1211,7 +1220,7 @@ static void CheckKeys(void)
             {   // stop transmitting
                 ProcessKey(KEY_PTT, false, false);
                 gPttIsPressed = false;
-                if (gKeyReading1 != KEY_INVALID)
+                if (gKeyboard.Reading1 != KEY_INVALID)
                     gPttWasReleased = true;
                 gPttOnePushCounter = 0;
                 #if defined(ENABLE_FEAT_F4HWN_CTR) || defined(ENABLE_FEAT_F4HWN_INV)
@@ -1234,7 +1243,7 @@ static void CheckKeys(void)
                 {   // stop transmitting
                     ProcessKey(KEY_PTT, false, false);
                     gPttIsPressed = false;
-                    if (gKeyReading1 != KEY_INVALID)
+                    if (gKeyboard.Reading1 != KEY_INVALID)
                         gPttWasReleased = true;
                     #if defined(ENABLE_FEAT_F4HWN_CTR) || defined(ENABLE_FEAT_F4HWN_INV)
                     ST7565_ContrastAndInv();
@@ -1266,7 +1275,7 @@ static void CheckKeys(void)
             {   // stop transmitting
                 ProcessKey(KEY_PTT, false, false);
                 gPttIsPressed = false;
-                if (gKeyReading1 != KEY_INVALID)
+                if (gKeyboard.Reading1 != KEY_INVALID)
                     gPttWasReleased = true;
             }
         }
@@ -1295,63 +1304,15 @@ static void CheckKeys(void)
     if (Key != KEY_INVALID) // any key pressed
         boot_counter_10ms = 0;   // cancel boot screen/beeps if any key pressed
 
-    if (gKeyReading0 != Key) // new key pressed
-    {
-
-        if (gKeyReading0 != KEY_INVALID && Key != KEY_INVALID)
-            ProcessKey(gKeyReading1, false, gKeyBeingHeld);  // key pressed without releasing previous key
-
-        gKeyReading0     = Key;
-        gDebounceCounter = 0;
-        return;
-    }
-
-    gDebounceCounter++;
-
-    if (gDebounceCounter == key_debounce_10ms) // debounced new key pressed
-    {
-        if (Key == KEY_INVALID) //all non PTT keys released
-        {
-            if (gKeyReading1 != KEY_INVALID) // some button was pressed before
-            {
-                ProcessKey(gKeyReading1, false, gKeyBeingHeld); // process last button released event
-                gKeyReading1 = KEY_INVALID;
-            }
-        }
-        else // process new key pressed
-        {
-            gKeyReading1 = Key;
-            ProcessKey(Key, true, false);
-        }
-
-        gKeyBeingHeld = false;
-        return;
-    }
-
-    if (gDebounceCounter < key_repeat_delay_10ms || Key == KEY_INVALID) // the button is not held long enough for repeat yet, or not really pressed
-        return;
+    KEYBOARD_Update(&gKeyboard, Key, &key_timing);
 
-    if (gDebounceCounter == key_repeat_delay_10ms) //initial key repeat with longer delay
+    KEY_Event_t Event;
+    while (KEYBOARD_GetEvent(&Event))
     {
-        if (Key != KEY_PTT)
-        {
-            gKeyBeingHeld = true;
-            ProcessKey(Key, true, true); // key held event
-        }
-    }
-    else //subsequent fast key repeats
-    {
-        if (Key == KEY_UP || Key == KEY_DOWN) // fast key repeats for up/down buttons
-        {
-            gKeyBeingHeld = true;
-            if ((gDebounceCounter % key_repeat_10ms) == 0)
-                ProcessKey(Key, true, true); // key held event
-        }
-
-        if (gDebounceCounter < 0xFFFF)
-            return;
-
-        gDebounceCounter = key_repeat_delay_10ms+1;
+        gKeyBeingHeld = Event.Held;
+        ProcessKey(Event.Key, Event.Type != KEY_EVENT_RELEASE, Event.Held);
+        if (Event.Type == KEY_EVENT_RELEASE)
+            gKeyBeingHeld = false;
     }
 }
 
@@ -1361,15 +1322,17 @@ void APP_TimeSlice10ms(void)
     gFlashLightBlinkCounter++;
 
 #ifdef ENABLE_AM_FIX
-    if (gRxVfo->Modulation == MODULATION_AM) {
-        AM_fix_10ms(gEeprom.RX_VFO);
-    }
+    AM_fix_10ms(gEeprom.RX_VFO, gRxVfo->Modulation);
 #endif
 
 #ifdef ENABLE_CW
     CW_HandleAutomaticTransmission();
 #endif
 
+#ifdef ENABLE_EXTRA_UART_CMD
+    TELEMETRY_TimeSlice10ms();
+#endif
+
 #ifdef ENABLE_UART
     if (UART_IsCommandAvailable()) {
         __disable_irq();
@@ -1384,6 +1347,8 @@ void APP_TimeSlice10ms(void)
     if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode)
         CheckRadioInterrupts();
 
+    DTMF_RX_Process();
+
     if (gCurrentFunction == FUNCTION_TRANSMIT)
     {   // transmitting
 #ifdef ENABLE_AUDIO_BAR
@@ -1492,6 +1457,8 @@ void APP_TimeSlice10ms(void)
     }
 
 #ifdef ENABLE_FMRADIO
+    FM_BackgroundScan_10ms();
+
     if (gFmRadioMode && gFM_RestoreCountdown_10ms > 0) {
         if (--gFM_RestoreCountdown_10ms == 0) { 
             FM_Start(); // switch back to FM radio mode
@@ -1545,7 +1512,7 @@ void APP_TimeSlice500ms(void)
 
     if (gKeypadLocked > 0)
         if (--gKeypadLocked == 0)
-            gUpdateDisplay = true;
+            UI_MAIN_UpdatePopup();
 
     if (gKeyInputCountdown > 0)
     {
@@ -1970,7 +1937,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
         // close low battery popup
         if(Key == KEY_EXIT && bKeyPressed && lowBatPopup) {
             gLowBatteryConfirmed = true;
-            gUpdateDisplay = true;
+            UI_MAIN_UpdatePopup();
             AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
             return;
         }
@@ -1982,7 +1949,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
             if (!bKeyHeld) { // keypad is locked, tell the user
                 AUDIO_PlayBeep(BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL);
                 gKeypadLocked  = 4;      // 2 seconds
-                gUpdateDisplay = true;
+                UI_MAIN_UpdatePopup();
                 return;
             }
         }
@@ -1999,7 +1966,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
             // keypad is locked, tell the user
             AUDIO_PlayBeep(BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL);
             gKeypadLocked  = 4;          // 2 seconds
-            gUpdateDisplay = true;
+            UI_MAIN_UpdatePopup();
             return;
         }
     }
@@ -2154,12 +2121,13 @@ Skip:
         gFlagAcceptSetting  = false;
     }
 
-    if (gRequestSaveSettings) {
+    if (gRequestSaveSettings || gSettingsDirty) {
         if (!bKeyHeld)
-            SETTINGS_SaveSettings();
+            SETTINGS_SaveSettingsBlocks(gRequestSaveSettings ? SETTINGS_BLOCKS_ALL : gSettingsDirty);
         else
             flagSaveSettings = 1;
         gRequestSaveSettings = false;
+        gSettingsDirty       = 0;
         gUpdateStatus        = true;
     }
 
@@ -4,6 +4,7 @@
 #include "functions.h"
 #include "misc.h"
 #include "settings.h"
+#include "trace.h"
 //#include "debugging.h"
 
 int8_t            gScanStateDir;
@@ -34,7 +35,7 @@ uint8_t             initialCROSS_BAND_RX_TX;
     uint32_t lastFoundFrqOrChanOld;
 #endif
 
-static void NextFreqChannel(void);
+static void NextFreqChannel(const bool retune);
 static void NextMemChannel(void);
 
 void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_direction)
@@ -65,7 +66,7 @@ void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_directi
             initialFrqOrChan = gRxVfo->freq_config_RX.Frequency;
             lastFoundFrqOrChan = initialFrqOrChan;
         }
-        NextFreqChannel();
+        NextFreqChannel(false);
     }
 
 #ifdef ENABLE_FEAT_F4HWN
@@ -86,7 +87,7 @@ void CHFRSCANNER_ContinueScanning(void)
         if (gCurrentFunction == FUNCTION_INCOMING)
             APP_StartListening(gMonitor ? FUNCTION_MONITOR : FUNCTION_RECEIVE);
         else
-            NextFreqChannel();  // switch to next frequency
+            NextFreqChannel(true);  // switch to next frequency
     }
     else
     {
@@ -111,7 +112,7 @@ void CHFRSCANNER_ContinueScanning(void)
     }
     else
     {
-        IS_FREQ_CHANNEL(gNextMrChannel) ? NextFreqChannel() : NextMemChannel();
+        IS_FREQ_CHANNEL(gNextMrChannel) ? NextFreqChannel(true) : NextMemChannel();
     }
 
     gScanPauseMode      = false;
@@ -224,8 +225,11 @@ void CHFRSCANNER_Stop(void)
     gUpdateDisplay = true;
 }
 
-static void NextFreqChannel(void)
+// retune: the RX registers are already set up for gRxVfo, only the frequency changes
+static void NextFreqChannel(const bool retune)
 {
+    const uint32_t PrevFrequency = gRxVfo->freq_config_RX.Frequency;
+
 #ifdef ENABLE_SCAN_RANGES
     if(gScanRangeStart) {
         gRxVfo->freq_config_RX.Frequency = APP_SetFreqByStepAndLimits(gRxVfo, gScanStateDir, gScanRangeStart, gScanRangeStop);
@@ -234,12 +238,17 @@ static void NextFreqChannel(void)
 #endif
         gRxVfo->freq_config_RX.Frequency = APP_SetFrequencyByStep(gRxVfo, gScanStateDir);
 
+    TRACE_FREQ(TRACE_SCAN_FREQ, gRxVfo->freq_config_RX.Frequency);
+
     RADIO_ApplyOffset(gRxVfo);
     RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
-    RADIO_SetupRegisters(true);
+    if (retune)
+        RADIO_RetuneRX(PrevFrequency);
+    else
+        RADIO_SetupRegisters(true);
 
 #ifdef ENABLE_FASTER_CHANNEL_SCAN
-    gScanPauseDelayIn_10ms = 9;   // 90ms
+    gScanPauseDelayIn_10ms = 6;   // 60ms, the retune waits for the PLL to lock so this only covers the squelch response
 #else
     gScanPauseDelayIn_10ms = scan_pause_delay_in_6_10ms;
 #endif
@@ -351,6 +360,8 @@ static void NextMemChannel(void)
         gEeprom.MrChannel[    gEeprom.RX_VFO] = gNextMrChannel;
         gEeprom.ScreenChannel[gEeprom.RX_VFO] = gNextMrChannel;
 
+        TRACE(TRACE_SCAN_CHANNEL, gNextMrChannel);
+
         RADIO_ConfigureChannel(gEeprom.RX_VFO, VFO_CONFIGURE_RELOAD);
         RADIO_SetupRegisters(true);
 
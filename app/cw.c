@@ -3,6 +3,8 @@
 #include "../driver/eeprom.h"
 #include "../driver/bk4819.h"
 #include "../driver/system.h"
+#include "../external/printf/printf.h"
+#include "../functions.h"
 #include "radio.h"
 #include "app.h"
 #include "misc.h"
@@ -53,10 +55,113 @@ void CW_SaveSettings(void)
     }
 }
 
-static void CW_Transmit_Pips(uint8_t count)
+// one byte per character, elements packed LSB first (0 = dot, 1 = dash)
+// above a single '1' end marker, so ".-" is 0b110
+static const uint8_t morse_code[] = {
+    0x3F,   // 0 -----
+    0x3E,   // 1 .----
+    0x3C,   // 2 ..---
+    0x38,   // 3 ...--
+    0x30,   // 4 ....-
+    0x20,   // 5 .....
+    0x21,   // 6 -....
+    0x23,   // 7 --...
+    0x27,   // 8 ---..
+    0x2F,   // 9 ----.
+    0x06,   // A .-
+    0x11,   // B -...
+    0x15,   // C -.-.
+    0x09,   // D -..
+    0x02,   // E .
+    0x14,   // F ..-.
+    0x0B,   // G --.
+    0x10,   // H ....
+    0x04,   // I ..
+    0x1E,   // J .---
+    0x0D,   // K -.-
+    0x12,   // L .-..
+    0x07,   // M --
+    0x05,   // N -.
+    0x0F,   // O ---
+    0x16,   // P .--.
+    0x1B,   // Q --.-
+    0x0A,   // R .-.
+    0x08,   // S ...
+    0x03,   // T -
+    0x0C,   // U ..-
+    0x18,   // V ...-
+    0x0E,   // W .--
+    0x19,   // X -..-
+    0x1D,   // Y -.--
+    0x13,   // Z --..
+    0x6A,   // . .-.-.-
+    0x73,   // , --..--
+    0x4C,   // ? ..--..
+    0x31,   // = -...-
+    0x29,   // / -..-.
+};
+
+#define CW_WORD_SPACE 0     // queue entry for a ' '
+#define CW_PIP        0x03  // a pip is keyed like a 'T'
+
+// packed code of a character, CW_WORD_SPACE for a space, 0xFF if it can't be sent
+static uint8_t CW_Encode(const char c)
 {
-    if (!gCWSettings.enabled || count == 0)
-        return;
+    if (c == ' ')
+        return CW_WORD_SPACE;
+    if (c >= '0' && c <= '9')
+        return morse_code[c - '0'];
+    if (c >= 'A' && c <= 'Z')
+        return morse_code[c - 'A' + 10];
+    if (c >= 'a' && c <= 'z')
+        return morse_code[c - 'a' + 10];
+    if (c == '.') return morse_code[36];
+    if (c == ',') return morse_code[37];
+    if (c == '?') return morse_code[38];
+    if (c == '=') return morse_code[39];
+    if (c == '/') return morse_code[40];
+    return 0xFF;
+}
+
+// the keyer sends the queued characters element by element from the 10ms
+// time slice, the main loop (keys, display, UART) keeps running meanwhile
+
+#define CW_QUEUE_SIZE 32
+
+static struct {
+    uint8_t  queue[CW_QUEUE_SIZE];  // packed characters still to send
+    uint8_t  length;
+    uint8_t  pos;
+    uint8_t  code;                  // elements left of the current character
+    bool     active;
+    bool     key_down;
+    uint16_t dot_ms;
+    int16_t  remaining_ms;          // of the current key down/up period
+} keyer;
+
+static void CW_Keyer_Start(const char *str, const uint8_t count, uint8_t wpm)
+{
+    if (wpm == 0)
+        wpm = 12;
+
+    keyer.length = 0;
+    if (str != NULL) {
+        for (size_t i = 0; str[i] != '\0' && keyer.length < CW_QUEUE_SIZE; i++) {
+            const uint8_t code = CW_Encode(str[i]);
+            if (code != 0xFF)
+                keyer.queue[keyer.length++] = code;
+        }
+    } else {
+        keyer.length = MIN(count, CW_QUEUE_SIZE);
+        memset(keyer.queue, CW_PIP, keyer.length);
+    }
+
+    keyer.pos          = 0;
+    keyer.code         = 1;
+    keyer.key_down     = false;
+    keyer.dot_ms       = 1200 / wpm;
+    keyer.remaining_ms = 50;        // let the TX link settle before the first element
+    keyer.active       = true;
 
     // Set up the transmitter for sending a tone
     BK4819_EnterTxMute();
@@ -64,87 +169,124 @@ static void CW_Transmit_Pips(uint8_t count)
     BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | (66u << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
     BK4819_WriteRegister(BK4819_REG_71, (((uint32_t)gCWSettings.tone_hz * 1353245u) + (1u << 16)) >> 17);
     BK4819_EnableTXLink();
-    SYSTEM_DelayMs(50);
+}
 
-    uint32_t dot_duration = 1200 / gCWSettings.wpm;
+static void CW_Keyer_Stop(void)
+{
+    if (!keyer.active)
+        return;
 
-    for (uint8_t i = 0; i < count; i++) {
-        BK4819_ExitTxMute();
-        SYSTEM_DelayMs(dot_duration * 3); // Dash duration
-        BK4819_EnterTxMute();
-        SYSTEM_DelayMs(dot_duration * 3); // space between pips, same as a dash
-    }
+    keyer.active = false;
+    BK4819_EnterTxMute();
 
     // Stop the tone generator
     BK4819_WriteRegister(BK4819_REG_70, 0);
 }
 
+// move on to the next key down/up period, false once the queue is done
+static bool CW_Keyer_NextPeriod(void)
+{
+    if (keyer.key_down) {
+        BK4819_EnterTxMute();               // Stop transmitting tone
+        keyer.key_down      = false;
+        keyer.remaining_ms += keyer.dot_ms; // Inter-element gap
+        if (keyer.code == 1)
+            keyer.remaining_ms += keyer.dot_ms * 2; // Inter-letter space (3 units) - inter-element (1) = 2
+        return true;
+    }
 
-static uint32_t CW_Calculate_String_OnAir_ms(const char *str, uint8_t wpm) {
-    if (wpm == 0) wpm = 12;
-    uint32_t dot_duration_ms = 1200 / wpm;
-    uint32_t on_air_duration_ms = 0;
+    if (keyer.code <= 1) {
+        if (keyer.pos >= keyer.length)
+            return false;
 
-    for (size_t i = 0; str[i] != '\0'; i++)
-    {
-        char c = str[i];
-        if (c == ' ') {
-            continue;
+        keyer.code = keyer.queue[keyer.pos++];
+        if (keyer.code == CW_WORD_SPACE) {
+            keyer.code          = 1;
+            keyer.remaining_ms += keyer.dot_ms * 4; // Word space (7 units) - inter-letter (3) = 4
+            return true;
         }
+    }
 
-        int code_char = get_morse_code_char(c);
-        if (code_char != -1)
-        {
-            const char *code = morse_code[code_char];
-            for (size_t j = 0; code[j] != '\0'; j++)
-            {
-                if (code[j] == '.')
-                {
-                    on_air_duration_ms += dot_duration_ms;
-                }
-                else // '-'
-                {
-                    on_air_duration_ms += dot_duration_ms * 3;
-                }
-            }
+    BK4819_ExitTxMute();                    // Start transmitting tone
+    keyer.key_down      = true;
+    keyer.remaining_ms += (keyer.code & 1u) ? keyer.dot_ms * 3 : keyer.dot_ms;
+    keyer.code        >>= 1;
+    return true;
+}
+
+static void CW_Keyer_10ms(void)
+{
+    if (!keyer.active)
+        return;
+
+    // carry any overshoot into the next period so the average speed stays exact
+    keyer.remaining_ms -= 10;
+    while (keyer.remaining_ms <= 0) {
+        if (!CW_Keyer_NextPeriod()) {
+            CW_Keyer_Stop();
+            return;
         }
     }
-    return on_air_duration_ms;
 }
 
-static uint32_t CW_Calculate_String_Duration_ms(const char *str, uint8_t wpm) {
-    if (wpm == 0) wpm = 12;
-    uint32_t dot_duration_ms = 1200 / wpm;
-    uint32_t total_duration_ms = 0;
+void CW_Transmit_String(const char *str, uint8_t wpm)
+{
+    if (!gCWSettings.enabled)
+        return;
 
-    for (size_t i = 0; str[i] != '\0'; i++)
-    {
-        char c = str[i];
-        if (c == ' ') {
-            total_duration_ms += dot_duration_ms * 4; // from transmit function
+    // used inside the end of transmission sequence, which is itself blocking
+    CW_Keyer_Start(str, 0, wpm);
+    while (keyer.active) {
+        SYSTEM_DelayMs(10);
+        CW_Keyer_10ms();
+    }
+}
+
+#ifdef ENABLE_SOS
+// total and key down time of a message in dot units
+static uint32_t CW_MessageUnits(const char *str, uint32_t *pOnAir)
+{
+    uint32_t total  = 0;
+    uint32_t on_air = 0;
+
+    for (size_t i = 0; str[i] != '\0'; i++) {
+        uint8_t code = CW_Encode(str[i]);
+        if (code == CW_WORD_SPACE) {
+            total += 4;
             continue;
         }
+        if (code == 0xFF)
+            continue;
 
-        int code_char = get_morse_code_char(c);
-        if (code_char != -1)
-        {
-            const char *code = morse_code[code_char];
-            for (size_t j = 0; code[j] != '\0'; j++)
-            {
-                if (code[j] == '.')
-                {
-                    total_duration_ms += dot_duration_ms;
-                }
-                else // '-'
-                {
-                    total_duration_ms += dot_duration_ms * 3;
-                }
-                total_duration_ms += dot_duration_ms; // Inter-element gap
-            }
-            total_duration_ms += dot_duration_ms * 2; // Inter-letter space
+        for (; code > 1; code >>= 1) {
+            const uint32_t units = (code & 1u) ? 3 : 1;
+            on_air += units;
+            total  += units + 1;
         }
+        total += 2;
     }
-    return total_duration_ms;
+
+    *pOnAir = on_air;
+    return total;
+}
+#endif
+
+static bool CW_StartBeacon(const char *str, const uint8_t count, const uint8_t wpm)
+{
+    RADIO_PrepareTX();
+    if (gCurrentFunction != FUNCTION_TRANSMIT)
+        return false;   // TX not allowed here
+
+    CW_Keyer_Start(str, count, wpm);
+    return true;
+}
+
+static void CW_EndBeacon(void)
+{
+    CW_Keyer_Stop();
+    APP_EndTransmission();
+    FUNCTION_Select(FUNCTION_FOREGROUND);
+    gFlagEndTransmission = false;
 }
 
 void CW_HandleAutomaticTransmission(void)
@@ -154,39 +296,38 @@ void CW_HandleAutomaticTransmission(void)
 #ifdef ENABLE_SOS
 	static uint32_t sos_countdown = 0;
 #endif
-	static bool transmitting = false;
 
-	if (transmitting) {
+	if (keyer.active) {
+		if (gCurrentFunction != FUNCTION_TRANSMIT) {
+			CW_Keyer_Stop();    // TX was ended elsewhere (PTT, timeout)
+			return;
+		}
+
+		CW_Keyer_10ms();
+		if (!keyer.active)
+			CW_EndBeacon();
+		return;
+	}
+
+	if (!gCWSettings.enabled) {
 		return;
 	}
 
 	if (gCWSettings.fox_hunt_enabled) {
 		if (pip_countdown == 0) {
-			if (gCWSettings.pip_count > 0) {
-				transmitting = true;
-				RADIO_PrepareTX();
-				CW_Transmit_Pips(gCWSettings.pip_count);
-				APP_EndTransmission();
-				FUNCTION_Select(FUNCTION_FOREGROUND);
-				gFlagEndTransmission = false;
-				transmitting = false;
-			}
 			pip_countdown = (uint32_t)gCWSettings.pip_interval * 100;
+			if (gCWSettings.pip_count > 0 && CW_StartBeacon(NULL, gCWSettings.pip_count, gCWSettings.wpm)) {
+				return;
+			}
 		} else {
 			pip_countdown--;
 		}
-		
+
 		if (id_countdown == 0) {
-			if (strlen(gCWSettings.callsign) > 0) {
-				transmitting = true;
-				RADIO_PrepareTX();
-				CW_Transmit_String(gCWSettings.callsign, gCWSettings.wpm);
-				APP_EndTransmission();
-				FUNCTION_Select(FUNCTION_FOREGROUND);
-				gFlagEndTransmission = false;
-				transmitting = false;
-			}
 			id_countdown = (uint32_t)gCWSettings.id_interval * 60 * 100;
+			if (strlen(gCWSettings.callsign) > 0 && CW_StartBeacon(gCWSettings.callsign, 0, gCWSettings.wpm)) {
+				return;
+			}
 		} else {
 			id_countdown--;
 		}
@@ -198,117 +339,30 @@ void CW_HandleAutomaticTransmission(void)
 #ifdef ENABLE_SOS
     if (gCWSettings.sos_mode_enabled) {
         if (sos_countdown == 0) {
-            transmitting = true;
-
             char sos_message[32] = "SOS";
             if (strlen(gCWSettings.grid_square) > 0) {
                 sprintf(sos_message, "SOS %s", gCWSettings.grid_square);
             }
 
-            RADIO_PrepareTX();
-            CW_Transmit_String(sos_message, 10);
-            APP_EndTransmission();
-            FUNCTION_Select(FUNCTION_FOREGROUND);
-            gFlagEndTransmission = false;
-            transmitting = false;
-
-            // Calculate the delay needed for the desired duty cycle
-            uint32_t sos_on_time_ms = CW_Calculate_String_OnAir_ms(sos_message, 10);
-            uint32_t sos_total_tx_time_ms = CW_Calculate_String_Duration_ms(sos_message, 10);
+            // Calculate the delay needed for the desired duty cycle, counted once the message is sent
+            uint32_t sos_on_time_units;
+            const uint32_t sos_total_units = CW_MessageUnits(sos_message, &sos_on_time_units);
 
             if (gCWSettings.sos_duty_cycle > 0 && gCWSettings.sos_duty_cycle <= 50) {
-                uint32_t total_period_ms = (sos_on_time_ms * 100) / gCWSettings.sos_duty_cycle;
-                uint32_t pause_duration_ms = total_period_ms > sos_total_tx_time_ms ? total_period_ms - sos_total_tx_time_ms : 0;
+                const uint32_t dot_duration_ms   = 1200 / 10;
+                const uint32_t total_period_ms   = (sos_on_time_units * dot_duration_ms * 100) / gCWSettings.sos_duty_cycle;
+                const uint32_t total_tx_time_ms  = sos_total_units * dot_duration_ms;
+                const uint32_t pause_duration_ms = total_period_ms > total_tx_time_ms ? total_period_ms - total_tx_time_ms : 0;
                 sos_countdown = pause_duration_ms / 10;
             } else {
                 // Default to a reasonable pause if duty cycle is invalid (e.g. 5 seconds)
                 sos_countdown = 500;
             }
+
+            CW_StartBeacon(sos_message, 0, 10);
         } else {
             sos_countdown--;
         }
     }
 #endif
 }
-
-static const char *morse_code[] = {
-    /* 0-9 */
-    "-----", ".----", "..---", "...--", "....-", ".....", "-....", "--...", "---..", "----.",
-    /* A-Z */
-    ".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---", "-.- ", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-", "..-", "...-", ".--", "-..-", "-.--", "--..",
-    /* punctuation */
-    ".-.-.-", /* . */
-    "--..--", /* , */
-    "..--..", /* ? */
-    "-...-",  /* = */
-    "-..-.",  /* / */
-};
-
-static int get_morse_code_char(const char c)
-{
-    if (c >= '0' && c <= '9')
-        return c - '0';
-    if (c >= 'A' && c <= 'Z')
-        return c - 'A' + 10;
-    if (c >= 'a' && c <= 'z')
-        return c - 'a' + 10;
-    if (c == '.') return 36;
-    if (c == ',') return 37;
-    if (c == '?') return 38;
-    if (c == '=') return 39;
-    if (c == '/') return 40;
-    return -1;
-}
-
-void CW_Transmit_String(const char *str, uint8_t wpm)
-{
-    if (!gCWSettings.enabled)
-        return;
-
-    if (wpm == 0) {
-        wpm = 12;
-    }
-
-    uint32_t dot_duration = 1200 / wpm;
-
-    // Set up the transmitter for sending a tone
-    BK4819_EnterTxMute();
-    BK4819_SetAF(BK4819_AF_MUTE);
-    BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | (66u << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
-    BK4819_WriteRegister(BK4819_REG_71, (((uint32_t)gCWSettings.tone_hz * 1353245u) + (1u << 16)) >> 17);
-    BK4819_EnableTXLink();
-    SYSTEM_DelayMs(50);
-
-    for (size_t i = 0; str[i] != '\0'; i++)
-    {
-        char c = str[i];
-        if (c == ' ') {
-            SYSTEM_DelayMs(dot_duration * 4); // Word space (7 units) - inter-letter (3) = 4
-            continue;
-        }
-
-        int code_char = get_morse_code_char(c);
-        if (code_char != -1)
-        {
-            const char *code = morse_code[code_char];
-            for (size_t j = 0; code[j] != '\0'; j++)
-            {
-                BK4819_ExitTxMute(); // Start transmitting tone
-                if (code[j] == '.')
-                {
-                    SYSTEM_DelayMs(dot_duration);
-                }
-                else
-                {
-                    SYSTEM_DelayMs(dot_duration * 3);
-                }
-                BK4819_EnterTxMute(); // Stop transmitting tone
-                SYSTEM_DelayMs(dot_duration); // Inter-element gap
-            }
-            SYSTEM_DelayMs(dot_duration * 2); // Inter-letter space (3 units) - inter-element (1) = 2
-        }
-    }
-
-    // Stop the tone generator
-    BK4819_WriteRegister(BK4819_REG_70, 0);
-}
\ No newline at end of file
@@ -67,6 +67,7 @@ void CW_LoadSettings(void);
 // Save CW settings to EEPROM
 void CW_SaveSettings(void);
 
+// called from the 10ms time slice, runs the beacons and the non-blocking keyer
 void CW_HandleAutomaticTransmission(void);
 
 void CW_Transmit_String(const char* str, uint8_t wpm);
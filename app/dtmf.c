@@ -69,12 +69,33 @@ bool              gDTMF_IsGroupCall;
 DTMF_ReplyState_t gDTMF_ReplyState;
 
 #ifdef ENABLE_DTMF_CALLING
+enum {
+    DTMF_MATCH_KILL = 0,
+    DTMF_MATCH_REVIVE,
+    DTMF_MATCH_ACK,
+    DTMF_MATCH_RESPONSE,
+    DTMF_MATCH_CALL,
+    DTMF_MATCH_N
+};
+
+// shift-and automaton per pattern, fed one received character at a time
+// bit i of a state is set when the last i+1 characters match the start of the pattern
+static uint32_t DTMF_MatchState[DTMF_MATCH_N];
+static uint32_t DTMF_MatchGroup[DTMF_MATCH_N];   // the partial matches that needed the group call code
+static uint8_t  DTMF_Matched;                    // bit per pattern, matched on the last character
+static uint8_t  DTMF_MatchedGroup;
+
 void DTMF_clear_RX(void)
 {
     gDTMF_RX_timeout = 0;
     gDTMF_RX_index   = 0;
     gDTMF_RX_pending = false;
     memset(gDTMF_RX, 0, sizeof(gDTMF_RX));
+
+    memset(DTMF_MatchState, 0, sizeof(DTMF_MatchState));
+    memset(DTMF_MatchGroup, 0, sizeof(DTMF_MatchGroup));
+    DTMF_Matched      = 0;
+    DTMF_MatchedGroup = 0;
 }
 #endif
 
@@ -186,18 +207,78 @@ char DTMF_GetCharacter(const unsigned int code)
     }
 }
 #ifdef ENABLE_DTMF_CALLING
-static bool CompareMessage(const char *pMsg, const char *pTemplate, const unsigned int size, const bool bCheckGroup)
+// the pattern is the concatenation of up to 3 parts, '?' matches any character
+static bool DTMF_GetPattern(const unsigned int id, const char *pParts[3])
 {
-    unsigned int i;
-    for (i = 0; i < size; i++)
+    static char separator[2];
+
+    separator[0] = gEeprom.DTMF_SEPARATE_CODE;
+
+    switch (id)
     {
-        if (pMsg[i] != pTemplate[i])
-        {
-            if (!bCheckGroup || pMsg[i] != gEeprom.DTMF_GROUP_CALL_CODE)
-                return false;
-            gDTMF_IsGroupCall = true;
+        case DTMF_MATCH_KILL:
+            pParts[0] = gEeprom.ANI_DTMF_ID; pParts[1] = separator; pParts[2] = gEeprom.KILL_CODE;
+            return true;    // the group call code may stand in for any character
+        case DTMF_MATCH_REVIVE:
+            pParts[0] = gEeprom.ANI_DTMF_ID; pParts[1] = separator; pParts[2] = gEeprom.REVIVE_CODE;
+            return true;
+        case DTMF_MATCH_ACK:
+            pParts[0] = "AB";                pParts[1] = "";        pParts[2] = "";
+            return true;
+        case DTMF_MATCH_RESPONSE:
+            pParts[0] = gDTMF_String;        pParts[1] = separator; pParts[2] = "AAAAA";
+            return false;
+        default:
+        case DTMF_MATCH_CALL:
+            pParts[0] = gEeprom.ANI_DTMF_ID; pParts[1] = separator; pParts[2] = "???";
+            return true;
+    }
+}
+
+static void DTMF_RX_Match(const char c)
+{
+    DTMF_Matched      = 0;
+    DTMF_MatchedGroup = 0;
+
+    for (unsigned int id = 0; id < DTMF_MATCH_N; id++) {
+        const char  *parts[3];
+        const bool   bCheckGroup = DTMF_GetPattern(id, parts);
+        uint32_t     exact = 0;
+        uint32_t     group = 0;
+        unsigned int len   = 0;
+
+        for (unsigned int p = 0; p < ARRAY_SIZE(parts); p++) {
+            for (const char *pStr = parts[p]; *pStr != 0 && len < 32; pStr++, len++) {
+                if (*pStr == c || *pStr == '?')
+                    exact |= 1u << len;
+                else if (bCheckGroup && c == gEeprom.DTMF_GROUP_CALL_CODE)
+                    group |= 1u << len;
+            }
+        }
+
+        const uint32_t next = (DTMF_MatchState[id] << 1) | 1u;
+        DTMF_MatchGroup[id] = ((DTMF_MatchGroup[id] << 1) & (exact | group)) | (next & group);
+        DTMF_MatchState[id] = next & (exact | group);
+
+        if (len == 0)
+            continue;
+
+        const uint32_t last = 1u << (len - 1);
+        if (DTMF_MatchState[id] & last) {
+            DTMF_Matched |= 1u << id;
+            if (DTMF_MatchGroup[id] & last)
+                DTMF_MatchedGroup |= 1u << id;
         }
     }
+}
+
+static bool DTMF_IsMatched(const unsigned int id)
+{
+    if (!(DTMF_Matched & (1u << id)))
+        return false;
+
+    if (DTMF_MatchedGroup & (1u << id))
+        gDTMF_IsGroupCall = true;
 
     return true;
 }
@@ -232,11 +313,64 @@ void DTMF_Append(const char code)
         gDTMF_InputBox[gDTMF_InputBox_Index++] = code;
 }
 
+// ring buffer between the BK4819 interrupt handling and the decoder
+#define DTMF_RX_FIFO_SIZE 16    // power of 2
+
+static char             DTMF_RX_fifo[DTMF_RX_FIFO_SIZE];
+static volatile uint8_t DTMF_RX_fifo_head;
+static volatile uint8_t DTMF_RX_fifo_tail;
+
+void DTMF_RX_Push(const char c)
+{
+    const uint8_t head = DTMF_RX_fifo_head;
+
+    if ((uint8_t)(head - DTMF_RX_fifo_tail) >= DTMF_RX_FIFO_SIZE)
+        return;     // full
+
+    DTMF_RX_fifo[head % DTMF_RX_FIFO_SIZE] = c;
+    DTMF_RX_fifo_head = head + 1;
+}
+
+void DTMF_RX_Process(void)
+{
+    while (DTMF_RX_fifo_tail != DTMF_RX_fifo_head) {
+        const char c = DTMF_RX_fifo[DTMF_RX_fifo_tail % DTMF_RX_FIFO_SIZE];
+        DTMF_RX_fifo_tail++;
+
+        if (gSetting_live_DTMF_decoder) {
+            size_t len = strlen(gDTMF_RX_live);
+            if (len >= sizeof(gDTMF_RX_live) - 1) { // make room
+                memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
+                len--;
+            }
+            gDTMF_RX_live[len++]  = c;
+            gDTMF_RX_live[len]    = 0;
+            gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  // time till we delete it
+            gUpdateDisplay        = true;
+        }
+
+#ifdef ENABLE_DTMF_CALLING
+        if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
+            if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) { // make room
+                memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
+                gDTMF_RX_index--;
+            }
+            gDTMF_RX[gDTMF_RX_index++] = c;
+            gDTMF_RX[gDTMF_RX_index]   = 0;
+            gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;  // time till we delete it
+            gDTMF_RX_pending           = true;
+
+            DTMF_RX_Match(c);
+            DTMF_HandleRequest();
+        }
+#endif
+    }
+}
+
 #ifdef ENABLE_DTMF_CALLING
 void DTMF_HandleRequest(void)
 {   // proccess the RX'ed DTMF characters
 
-    char         String[21];
     unsigned int Offset;
 
     if (!gDTMF_RX_pending)
@@ -259,11 +393,7 @@ void DTMF_HandleRequest(void)
     if (gDTMF_RX_index >= 9)
     {   // look for the KILL code
 
-        sprintf(String, "%s%c%s", gEeprom.ANI_DTMF_ID, gEeprom.DTMF_SEPARATE_CODE, gEeprom.KILL_CODE);
-
-        Offset = gDTMF_RX_index - strlen(String);
-
-        if (CompareMessage(gDTMF_RX + Offset, String, strlen(String), true))
+        if (DTMF_IsMatched(DTMF_MATCH_KILL))
         {   // bugger
 
             if (gEeprom.PERMIT_REMOTE_KILL)
@@ -300,11 +430,7 @@ void DTMF_HandleRequest(void)
     if (gDTMF_RX_index >= 9)
     {   // look for the REVIVE code
 
-        sprintf(String, "%s%c%s", gEeprom.ANI_DTMF_ID, gEeprom.DTMF_SEPARATE_CODE, gEeprom.REVIVE_CODE);
-
-        Offset = gDTMF_RX_index - strlen(String);
-
-        if (CompareMessage(gDTMF_RX + Offset, String, strlen(String), true))
+        if (DTMF_IsMatched(DTMF_MATCH_REVIVE))
         {   // shit, we're back !
 
             gSetting_KILLED  = false;
@@ -324,11 +450,8 @@ void DTMF_HandleRequest(void)
 
     if (gDTMF_RX_index >= 2)
     {   // look for ACK reply
-        char *pPrintStr = "AB";
 
-        Offset = gDTMF_RX_index - strlen(pPrintStr);
-
-        if (CompareMessage(gDTMF_RX + Offset, pPrintStr, strlen(pPrintStr), true)) {
+        if (DTMF_IsMatched(DTMF_MATCH_ACK)) {
             // ends with "AB"
 
             if (gDTMF_ReplyState != DTMF_REPLY_NONE)          // 1of11
@@ -348,11 +471,7 @@ void DTMF_HandleRequest(void)
         gDTMF_RX_index >= 9)
     {   // waiting for a reply
 
-        sprintf(String, "%s%c%s", gDTMF_String, gEeprom.DTMF_SEPARATE_CODE, "AAAAA");
-
-        Offset = gDTMF_RX_index - strlen(String);
-
-        if (CompareMessage(gDTMF_RX + Offset, String, strlen(String), false))
+        if (DTMF_IsMatched(DTMF_MATCH_RESPONSE))
         {   // we got a response
             gDTMF_State    = DTMF_STATE_CALL_OUT_RSP;
             DTMF_clear_RX();
@@ -370,13 +489,11 @@ void DTMF_HandleRequest(void)
 
         gDTMF_IsGroupCall = false;
 
-        sprintf(String, "%s%c", gEeprom.ANI_DTMF_ID, gEeprom.DTMF_SEPARATE_CODE);
-
-        Offset = gDTMF_RX_index - strlen(String) - 3;
-
-        if (CompareMessage(gDTMF_RX + Offset, String, strlen(String), true))
+        if (DTMF_IsMatched(DTMF_MATCH_CALL))
         {   // it's for us !
 
+            Offset = gDTMF_RX_index - strlen(gEeprom.ANI_DTMF_ID) - 1 - 3;
+
             gDTMF_CallState = DTMF_CALL_STATE_RECEIVED;
 
             memset(gDTMF_Callee, 0, sizeof(gDTMF_Callee));
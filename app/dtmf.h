@@ -87,6 +87,10 @@ void DTMF_Append(const char code);
 void DTMF_Reply(void);
 void DTMF_SendEndOfTransmission(void);
 
+// queue a character from the BK4819 DTMF interrupt, decoded later by DTMF_RX_Process()
+void DTMF_RX_Push(const char c);
+void DTMF_RX_Process(void);
+
 #ifdef ENABLE_DTMF_CALLING
 
 extern char              gDTMF_RX[17];
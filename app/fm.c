@@ -47,6 +47,23 @@ bool              gFM_FoundFrequency;
 bool              gFM_AutoScan;
 uint16_t          gFM_RestoreCountdown_10ms;
 
+typedef enum {
+    FM_BG_SCAN_OFF = 0,
+    FM_BG_SCAN_POWER_UP,
+    FM_BG_SCAN_SELECT,
+    FM_BG_SCAN_TUNE,
+    FM_BG_SCAN_CHECK,
+} FM_BackgroundScanState_t;
+
+// background scan runs on the BK1080 only, results are kept aside until the
+// sweep completes so that cancelling it leaves the stored channels untouched
+static FM_BackgroundScanState_t bgScanState;
+static uint8_t                  bgScanStep;
+static uint8_t                  bgScanWait_10ms;
+static uint8_t                  bgScanCount;
+static uint16_t                 bgScanFrequency;
+static uint16_t                 bgScanChannel;
+static uint16_t                 bgScanChannels[ARRAY_SIZE(gFM_Channels)];
 
 
 const uint8_t BUTTON_STATE_PRESSED = 1 << 0;
@@ -243,6 +260,98 @@ int FM_CheckFrequencyLock(uint16_t Frequency, uint16_t LowerLimit)
     return ret;
 }
 
+bool FM_IsBackgroundScanning(void)
+{
+    return bgScanState != FM_BG_SCAN_OFF;
+}
+
+void FM_StartBackgroundScan(void)
+{
+    if (gFmRadioMode || FM_IsBackgroundScanning())
+        return;
+
+    bgScanStep      = 0;
+    bgScanWait_10ms = 0;
+    bgScanCount     = 0;
+    bgScanFrequency = BK1080_GetFreqLoLimit(gEeprom.FM_Band);
+    bgScanState     = FM_BG_SCAN_POWER_UP;
+
+    memset(bgScanChannels, 0xFF, sizeof(bgScanChannels));
+
+    gUpdateStatus = true;
+}
+
+void FM_StopBackgroundScan(bool bSave)
+{
+    if (!FM_IsBackgroundScanning())
+        return;
+
+    bgScanState = FM_BG_SCAN_OFF;
+
+    if (bSave && bgScanCount > 0) {
+        memcpy(gFM_Channels, bgScanChannels, sizeof(gFM_Channels));
+        gEeprom.FM_IsMrMode        = true;
+        gEeprom.FM_SelectedChannel = 0;
+        FM_ConfigureChannelState();
+        SETTINGS_SaveFM();
+    }
+
+    if (!gFmRadioMode)
+        BK1080_Init0();
+
+    gUpdateStatus = true;
+}
+
+void FM_BackgroundScan_10ms(void)
+{
+    if (bgScanState == FM_BG_SCAN_OFF || gCurrentFunction == FUNCTION_TRANSMIT)
+        return;
+
+    if (bgScanWait_10ms > 0) {
+        bgScanWait_10ms--;
+        return;
+    }
+
+    switch (bgScanState) {
+        case FM_BG_SCAN_POWER_UP:
+            bgScanWait_10ms = BK1080_PowerUpStep(bgScanStep++);
+            if (bgScanWait_10ms == 0) {
+                // keep the BK1080 quiet, its audio output is shared with the BK4819
+                BK1080_Mute(true);
+                BK1080_GetFrequencyDeviation(bgScanFrequency);
+                bgScanState = FM_BG_SCAN_SELECT;
+            }
+            break;
+
+        case FM_BG_SCAN_SELECT:
+            bgScanChannel = BK1080_SelectFrequency(bgScanFrequency, gEeprom.FM_Band/*, gEeprom.FM_Space*/);
+            bgScanState   = FM_BG_SCAN_TUNE;
+            break;
+
+        case FM_BG_SCAN_TUNE:
+            BK1080_TuneChannel(bgScanChannel);
+            bgScanWait_10ms = fm_play_countdown_scan_10ms;
+            bgScanState     = FM_BG_SCAN_CHECK;
+            break;
+
+        case FM_BG_SCAN_CHECK:
+            if (!FM_CheckFrequencyLock(bgScanFrequency, BK1080_GetFreqLoLimit(gEeprom.FM_Band)))
+                bgScanChannels[bgScanCount++] = bgScanFrequency;
+
+            if (bgScanCount >= ARRAY_SIZE(bgScanChannels) || ++bgScanFrequency > BK1080_GetFreqHiLimit(gEeprom.FM_Band)) {
+                FM_StopBackgroundScan(true);
+                gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+                break;
+            }
+
+            bgScanState = FM_BG_SCAN_SELECT;
+            break;
+
+        default:
+            break;
+    }
+}
+
 static void Key_DIGITS(KEY_Code_t Key, uint8_t state)
 {
     enum { STATE_FREQ_MODE, STATE_MR_MODE, STATE_SAVE };
@@ -611,6 +720,8 @@ void FM_Play(void)
 
 void FM_Start(void)
 {
+    FM_StopBackgroundScan(false);
+
     gDualWatchActive          = false;
     gFmRadioMode              = true;
     gFM_ScanState             = FM_SCAN_OFF;
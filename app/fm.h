@@ -53,6 +53,13 @@ int     FM_CheckFrequencyLock(uint16_t Frequency, uint16_t LowerLimit);
 
 void    FM_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
+// FM band scan on the BK1080 alone, spread over the 10ms time slices so the
+// BK4819 keeps receiving (and dual watching) while the preset table is built
+bool    FM_IsBackgroundScanning(void);
+void    FM_StartBackgroundScan(void);
+void    FM_StopBackgroundScan(bool bSave);
+void    FM_BackgroundScan_10ms(void);
+
 void    FM_Play(void);
 void    FM_Start(void);
 
@@ -14,6 +14,7 @@
  *     limitations under the License.
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #if !defined(ENABLE_OVERLAY)
@@ -114,419 +115,324 @@ void MENU_StopCssScan(void)
     gUpdateStatus = true;
 }
 
-int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
-{
-    *pMin = 0;
-
-    switch (menu_id)
-    {
-        case MENU_SQL:
-            //*pMin = 0;
-            *pMax = 9;
-            break;
-
-        case MENU_STEP:
-            //*pMin = 0;
-            *pMax = STEP_N_ELEM - 1;
-            break;
-
-        case MENU_ABR:
-            //*pMin = 0;
-            *pMax = 61;
-            break;
+#define SETTING(var, lo, hi, blk, fl, fmt) \
+    {&(var), lo, hi, 0, fl, SETTINGS_BLOCK_##blk, MENU_FORMAT_##fmt}
+#define VFO_SETTING(field, lo, hi, fl, fmt) \
+    {NULL, lo, hi, offsetof(VFO_Info_t, field), MENU_F_VFO | (fl), SETTINGS_BLOCK_NONE, MENU_FORMAT_##fmt}
+#define LIMITS(lo, hi, fmt) \
+    {NULL, lo, hi, 0, 0, SETTINGS_BLOCK_NONE, MENU_FORMAT_##fmt}
+
+static const menu_setting_t MenuSettings[MENU_BATTYP + 1] = {
+    [MENU_SQL]          = SETTING(gEeprom.SQUELCH_LEVEL, 0, 9, 0E70, MENU_F_VFO_CONFIGURE, NUMBER),
+    [MENU_STEP]         = LIMITS(0, STEP_N_ELEM - 1, CUSTOM),
+    [MENU_TXP]          = VFO_SETTING(OUTPUT_POWER, 0, ARRAY_SIZE(gSubMenu_TXP) - 1, MENU_F_SAVE_CHANNEL, CUSTOM),
+    [MENU_R_DCS]        = LIMITS(0, 208, CUSTOM),
+    [MENU_R_CTCS]       = LIMITS(0, ARRAY_SIZE(CTCSS_Options), CUSTOM),
+    [MENU_T_DCS]        = LIMITS(0, 208, CUSTOM),
+    [MENU_T_CTCS]       = LIMITS(0, ARRAY_SIZE(CTCSS_Options), CUSTOM),
+    [MENU_SFT_D]        = VFO_SETTING(TX_OFFSET_FREQUENCY_DIRECTION, 0, ARRAY_SIZE(gSubMenu_SFT_D) - 1, MENU_F_SAVE_CHANNEL, SFT_D),
+    [MENU_TOT]          = SETTING(gEeprom.TX_TIMEOUT_TIMER, 5, 179, 0E70, 0, CUSTOM),
+    [MENU_W_N]          = VFO_SETTING(CHANNEL_BANDWIDTH, 0, ARRAY_SIZE(gSubMenu_W_N) - 1, MENU_F_SAVE_CHANNEL, W_N),
+#ifndef ENABLE_FEAT_F4HWN
+    [MENU_SCR]          = VFO_SETTING(SCRAMBLING_TYPE, 0, ARRAY_SIZE(gSubMenu_SCRAMBLER) - 1, MENU_F_SAVE_CHANNEL, CUSTOM),
+#endif
+    [MENU_BCL]          = VFO_SETTING(BUSY_CHANNEL_LOCK, 0, 1, MENU_F_SAVE_CHANNEL, OFF_ON),
+#ifdef ENABLE_FEAT_F4HWN
+    [MENU_TX_LOCK]      = VFO_SETTING(TX_LOCK, 0, 1, MENU_F_SAVE_CHANNEL, CUSTOM),
+#endif
+    [MENU_MEM_CH]       = LIMITS(0, MR_CHANNEL_LAST, CUSTOM),
+    [MENU_DEL_CH]       = LIMITS(0, MR_CHANNEL_LAST, CUSTOM),
+    [MENU_MEM_NAME]     = LIMITS(0, MR_CHANNEL_LAST, CUSTOM),
+    [MENU_MDF]          = SETTING(gEeprom.CHANNEL_DISPLAY_MODE, 0, ARRAY_SIZE(gSubMenu_MDF) - 1, 0E78, 0, CUSTOM),
+    [MENU_SAVE]         = SETTING(gEeprom.BATTERY_SAVE, 0, 5, 0E78, 0, CUSTOM),
+#ifdef ENABLE_VOX
+    [MENU_VOX]          = LIMITS(0, 10, CUSTOM),
+#endif
+    [MENU_ABR]          = LIMITS(0, 61, CUSTOM),
+    [MENU_ABR_ON_TX_RX] = SETTING(gSetting_backlight_on_tx_rx, 0, ARRAY_SIZE(gSubMenu_RX_TX) - 1, 0F40, 0, RX_TX),
+    [MENU_ABR_MIN]      = SETTING(gEeprom.BACKLIGHT_MIN, 0, 9, 0E78, 0, CUSTOM),
+    [MENU_ABR_MAX]      = SETTING(gEeprom.BACKLIGHT_MAX, 1, 10, 0E78, 0, CUSTOM),
+    [MENU_TDR]          = LIMITS(0, ARRAY_SIZE(gSubMenu_RXMode) - 1, CUSTOM),
+    [MENU_BEEP]         = SETTING(gEeprom.BEEP_CONTROL, 0, 1, 0E90, 0, OFF_ON),
+#ifdef ENABLE_VOICE
+    [MENU_VOICE]        = SETTING(gEeprom.VOICE_PROMPT, 0, ARRAY_SIZE(gSubMenu_VOICE) - 1, 0EA0, MENU_F_STATUS, VOICE),
+#endif
+    [MENU_SC_REV]       = SETTING(gEeprom.SCAN_RESUME_MODE, 0, 104, 0E90, 0, CUSTOM),
+    [MENU_AUTOLK]       = SETTING(gEeprom.AUTO_KEYPAD_LOCK, 0, 40, 0E90, 0, CUSTOM),
+    [MENU_S_ADD1]       = VFO_SETTING(SCANLIST1_PARTICIPATION, 0, 1, MENU_F_UPDATE_CHANNEL, OFF_ON),
+    [MENU_S_ADD2]       = VFO_SETTING(SCANLIST2_PARTICIPATION, 0, 1, MENU_F_UPDATE_CHANNEL, OFF_ON),
+    [MENU_S_ADD3]       = VFO_SETTING(SCANLIST3_PARTICIPATION, 0, 1, MENU_F_UPDATE_CHANNEL, OFF_ON),
+    [MENU_STE]          = SETTING(gEeprom.TAIL_TONE_ELIMINATION, 0, 1, 0E78, 0, OFF_ON),
+    [MENU_RP_STE]       = SETTING(gEeprom.REPEATER_TAIL_TONE_ELIMINATION, 0, 10, 0EA8, 0, CUSTOM),
+    [MENU_MIC]          = SETTING(gEeprom.MIC_SENSITIVITY, 0, 4, 0E70, MENU_F_RECONFIGURE, CUSTOM),
+#ifdef ENABLE_AUDIO_BAR
+    [MENU_MIC_BAR]      = SETTING(gSetting_mic_bar, 0, 1, 0F40, 0, OFF_ON),
+#endif
+    [MENU_COMPAND]      = VFO_SETTING(Compander, 0, ARRAY_SIZE(gSubMenu_RX_TX) - 1, MENU_F_UPDATE_CHANNEL, RX_TX),
+    [MENU_1_CALL]       = SETTING(gEeprom.CHAN_1_CALL, 0, MR_CHANNEL_LAST, 0E70, 0, CUSTOM),
+    [MENU_S_LIST]       = SETTING(gEeprom.SCAN_LIST_DEFAULT, 0, 5, 0F18, 0, CUSTOM),
+    [MENU_SLIST1]       = LIMITS(-1, MR_CHANNEL_LAST, CUSTOM),
+    [MENU_SLIST2]       = LIMITS(-1, MR_CHANNEL_LAST, CUSTOM),
+    [MENU_SLIST3]       = LIMITS(-1, MR_CHANNEL_LAST, CUSTOM),
+#ifdef ENABLE_ALARM
+    [MENU_AL_MOD]       = SETTING(gEeprom.ALARM_MODE, 0, ARRAY_SIZE(gSubMenu_AL_MOD) - 1, 0EA8, 0, AL_MOD),
+#endif
+    [MENU_PTT_ID]       = VFO_SETTING(DTMF_PTT_ID_TX_MODE, 0, ARRAY_SIZE(gSubMenu_PTT_ID) - 1, MENU_F_SAVE_CHANNEL, CUSTOM),
+    [MENU_D_ST]         = SETTING(gEeprom.DTMF_SIDE_TONE, 0, 1, 0ED0, 0, OFF_ON),
+#ifdef ENABLE_DTMF_CALLING
+    [MENU_D_RSP]        = SETTING(gEeprom.DTMF_DECODE_RESPONSE, 0, ARRAY_SIZE(gSubMenu_D_RSP) - 1, 0ED0, 0, D_RSP),
+    [MENU_D_HOLD]       = SETTING(gEeprom.DTMF_auto_reset_time, 5, 60, 0ED0, 0, CUSTOM),
+#endif
+    [MENU_D_PRE]        = LIMITS(3, 99, CUSTOM),
+#ifdef ENABLE_DTMF_CALLING
+    [MENU_D_DCD]        = VFO_SETTING(DTMF_DECODING_ENABLE, 0, 1, MENU_F_SAVE_CHANNEL, OFF_ON),
+    [MENU_D_LIST]       = LIMITS(1, 16, CUSTOM),
+#endif
+    [MENU_D_LIVE_DEC]   = SETTING(gSetting_live_DTMF_decoder, 0, 1, 0F40, MENU_F_RECONFIGURE | MENU_F_STATUS, OFF_ON),
+    [MENU_PONMSG]       = SETTING(gEeprom.POWER_ON_DISPLAY_MODE, 0, ARRAY_SIZE(gSubMenu_PONMSG) - 1, 0E90, 0, PONMSG),
+    [MENU_ROGER]        = SETTING(gEeprom.ROGER, 0, ARRAY_SIZE(gSubMenu_ROGER) - 1, 0EA8, 0, ROGER),
+    [MENU_BAT_TXT]      = SETTING(gSetting_battery_text, 0, ARRAY_SIZE(gSubMenu_BAT_TXT) - 1, 0F40, 0, BAT_TXT),
+    [MENU_AM]           = VFO_SETTING(Modulation, 0, ARRAY_SIZE(gModulationStr) - 1, MENU_F_SAVE_CHANNEL, CUSTOM),
+#if defined(ENABLE_AM_FIX) && !defined(ENABLE_FEAT_F4HWN)
+    [MENU_AM_FIX]       = SETTING(gSetting_AM_fix, 0, 1, 0F40, MENU_F_VFO_RELOAD, OFF_ON),
+#endif
+#ifdef ENABLE_NOAA
+    [MENU_NOAA_S]       = SETTING(gEeprom.NOAA_AUTO_SCAN, 0, 1, 0E70, MENU_F_RECONFIGURE, OFF_ON),
+#endif
+    [MENU_RESET]        = LIMITS(0, ARRAY_SIZE(gSubMenu_RESET) - 1, RESET),
+    [MENU_F_LOCK]       = LIMITS(0, ARRAY_SIZE(gSubMenu_F_LOCK) - 1, CUSTOM),
+#ifndef ENABLE_FEAT_F4HWN
+    [MENU_200TX]        = SETTING(gSetting_200TX, 0, 1, 0F40, 0, OFF_ON),
+    [MENU_350TX]        = SETTING(gSetting_350TX, 0, 1, 0F40, 0, OFF_ON),
+    [MENU_500TX]        = SETTING(gSetting_500TX, 0, 1, 0F40, 0, OFF_ON),
+#endif
+    [MENU_350EN]        = SETTING(gSetting_350EN, 0, 1, 0F40, MENU_F_VFO_RELOAD, OFF_ON),
+#ifndef ENABLE_FEAT_F4HWN
+    [MENU_SCREN]        = SETTING(gSetting_ScrambleEnable, 0, 1, 0F40, MENU_F_RECONFIGURE, OFF_ON),
+#endif
+#ifdef ENABLE_CW
+    [MENU_CW_ENABLED]   = SETTING(gCWSettings.enabled, 0, 1, CW, 0, OFF_ON),
+    [MENU_CW_WPM]       = SETTING(gCWSettings.wpm, 5, 50, CW, 0, CUSTOM),
+    [MENU_CW_TONE]      = SETTING(gCWSettings.tone_hz, 300, 1200, CW, MENU_F_U16, CUSTOM),
+    [MENU_CW_MODE]      = SETTING(gCWSettings.mode, 0, ARRAY_SIZE(gSubMenu_CW_MODE) - 1, CW, 0, CW_MODE),
+    [MENU_CW_FMCW]      = SETTING(gCWSettings.tx_mode, 0, ARRAY_SIZE(gSubMenu_CW_TX_Mode) - 1, CW, 0, CW_TX_MODE),
+    [MENU_CW_WN]        = SETTING(gCWSettings.bandwidth, 0, ARRAY_SIZE(gSubMenu_W_N) - 1, CW, 0, W_N),
+    [MENU_CW_EOT]       = SETTING(gCWSettings.eot_enabled, 0, 1, CW, 0, OFF_ON),
+    [MENU_CW_T_HUNT]    = SETTING(gCWSettings.fox_hunt_enabled, 0, 1, CW, 0, OFF_ON),
+    [MENU_CW_PIP_CNT]   = SETTING(gCWSettings.pip_count, 1, 20, CW, 0, NUMBER),
+    [MENU_CW_PIP_INT]   = SETTING(gCWSettings.pip_interval, 1, 60, CW, 0, CUSTOM),
+    [MENU_CW_ID_INT]    = SETTING(gCWSettings.id_interval, 1, 60, CW, 0, CUSTOM),
+    #ifdef ENABLE_SOS
+        [MENU_CW_SOS]   = SETTING(gCWSettings.sos_mode_enabled, 0, 1, CW, 0, CUSTOM),
+    #endif
+#endif
+#ifdef ENABLE_F_CAL_MENU
+    [MENU_F_CALI]       = LIMITS(-50, 50, CUSTOM),
+#endif
+#ifdef ENABLE_FEAT_F4HWN_SLEEP
+    [MENU_SET_OFF]      = SETTING(gSetting_set_off, 0, 120, 1FF0, 0, CUSTOM),
+#endif
+#ifdef ENABLE_FEAT_F4HWN
+    [MENU_SET_PWR]      = SETTING(gSetting_set_pwr, 0, ARRAY_SIZE(gSubMenu_SET_PWR) - 1, 1FF0, MENU_F_SAVE_CHANNEL, CUSTOM),
+    [MENU_SET_PTT]      = LIMITS(0, ARRAY_SIZE(gSubMenu_SET_PTT) - 1, SET_PTT),
+    [MENU_SET_TOT]      = SETTING(gSetting_set_tot, 0, ARRAY_SIZE(gSubMenu_SET_TOT) - 1, 1FF0, 0, SET_TOT),
+    [MENU_SET_EOT]      = SETTING(gSetting_set_eot, 0, ARRAY_SIZE(gSubMenu_SET_TOT) - 1, 1FF0, 0, SET_TOT),
+    #ifdef ENABLE_FEAT_F4HWN_CTR
+        [MENU_SET_CTR]  = SETTING(gSetting_set_ctr, 1, 15, 1FF0, 0, CUSTOM),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_INV
+        [MENU_SET_INV]  = SETTING(gSetting_set_inv, 0, 1, 1FF0, 0, CUSTOM),
+    #endif
+    [MENU_SET_LCK]      = SETTING(gSetting_set_lck, 0, ARRAY_SIZE(gSubMenu_SET_LCK) - 1, 1FF0, 0, SET_LCK),
+    [MENU_SET_MET]      = SETTING(gSetting_set_met, 0, ARRAY_SIZE(gSubMenu_SET_MET) - 1, 1FF0, 0, SET_MET),
+    [MENU_SET_GUI]      = SETTING(gSetting_set_gui, 0, ARRAY_SIZE(gSubMenu_SET_MET) - 1, 1FF0, 0, SET_MET),
+    [MENU_SET_TMR]      = SETTING(gSetting_set_tmr, 0, 1, 1FF0, 0, OFF_ON),
+    #ifdef ENABLE_FEAT_F4HWN_NARROWER
+        [MENU_SET_NFM]  = SETTING(gSetting_set_nfm, 0, ARRAY_SIZE(gSubMenu_SET_NFM) - 1, 0E78, 0, SET_NFM),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_VOL
+        [MENU_SET_VOL]  = SETTING(gEeprom.VOLUME_GAIN, 0, 63, VOL, 0, CUSTOM),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
+        [MENU_SET_KEY]  = SETTING(gEeprom.SET_KEY, 0, 4, 0E70, 0, SET_KEY),
+    #endif
+#endif
+    [MENU_BATCAL]       = LIMITS(1600, 2200, CUSTOM),
+    [MENU_BATTYP]       = SETTING(gEeprom.BATTERY_TYPE, 0, 2, 0EA8, 0, BATTYP),
+};
 
-        case MENU_ABR_MIN:
-            //*pMin = 0;
-            *pMax = 9;
-            break;
+const menu_setting_t *MENU_GetSetting(uint8_t menu_id)
+{
+    static const menu_setting_t none;
 
-        case MENU_ABR_MAX:
-            *pMin = 1;
-            *pMax = 10;
-            break;
+    return (menu_id < ARRAY_SIZE(MenuSettings)) ? &MenuSettings[menu_id] : &none;
+}
 
-        case MENU_F_LOCK:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_F_LOCK) - 1;
-            break;
+static bool MENU_HasStorage(const menu_setting_t *pSetting)
+{
+    return pSetting->storage != NULL || (pSetting->flags & MENU_F_VFO);
+}
 
-        case MENU_MDF:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_MDF) - 1;
-            break;
+static uint8_t *MENU_GetStorage(const menu_setting_t *pSetting)
+{
+    return (pSetting->flags & MENU_F_VFO) ? (uint8_t *)gTxVfo + pSetting->offset : pSetting->storage;
+}
 
-        case MENU_TXP:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_TXP) - 1;
-            break;
+static int32_t MENU_ReadSetting(const menu_setting_t *pSetting)
+{
+    const uint8_t *p = MENU_GetStorage(pSetting);
 
-        case MENU_SFT_D:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SFT_D) - 1;
-            break;
+    return (pSetting->flags & MENU_F_U16) ? *(const uint16_t *)p : *p;
+}
 
-        case MENU_TDR:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_RXMode) - 1;
-            break;
+static void MENU_WriteSetting(const menu_setting_t *pSetting, const int32_t value)
+{
+    uint8_t      *p     = MENU_GetStorage(pSetting);
+    const uint8_t flags = pSetting->flags;
 
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                //*pMin = 0;
-                *pMax = ARRAY_SIZE(gSubMenu_VOICE) - 1;
-                break;
-        #endif
+    if (flags & MENU_F_U16)
+        *(uint16_t *)p = value;
+    else
+        *p = value;
 
-        case MENU_SC_REV:
-            //*pMin = 0;
-            *pMax = 104;
-            break;
+    if (flags & MENU_F_SAVE_CHANNEL)
+        gRequestSaveChannel = 1;
 
-        case MENU_ROGER:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_ROGER) - 1;
-            break;
+    if (flags & MENU_F_UPDATE_CHANNEL) {
+        SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
+        gVfoConfigureMode = VFO_CONFIGURE;
+        gFlagResetVfos    = true;
+    }
 
-        case MENU_PONMSG:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_PONMSG) - 1;
-            break;
+    if (flags & MENU_F_VFO_CONFIGURE)
+        gVfoConfigureMode = VFO_CONFIGURE;
 
-        case MENU_R_DCS:
-        case MENU_T_DCS:
-            //*pMin = 0;
-            *pMax = 208;
-            //*pMax = (ARRAY_SIZE(DCS_Options) * 2);
-            break;
+    if (flags & MENU_F_VFO_RELOAD) {
+        gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
+        gFlagResetVfos    = true;
+    }
 
-        case MENU_R_CTCS:
-        case MENU_T_CTCS:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(CTCSS_Options);
-            break;
+    if (flags & MENU_F_RECONFIGURE)
+        gFlagReconfigureVfos = true;
 
-        case MENU_W_N:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_W_N) - 1;
-            break;
+    if (flags & MENU_F_STATUS)
+        gUpdateStatus = true;
 
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                //*pMin = 0;
-                *pMax = ARRAY_SIZE(gSubMenu_AL_MOD) - 1;
-                break;
-        #endif
+    if (pSetting->block != SETTINGS_BLOCK_NONE)
+        gSettingsDirty |= SETTINGS_BLOCK_BIT(pSetting->block);
+}
 
-        case MENU_RESET:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_RESET) - 1;
-            break;
+int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
+{
+    const menu_setting_t *pSetting = MENU_GetSetting(menu_id);
 
-        case MENU_COMPAND:
-        case MENU_ABR_ON_TX_RX:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_RX_TX) - 1;
-            break;
+    if (pSetting->max > pSetting->min) {
+        *pMin = pSetting->min;
+        *pMax = pSetting->max;
+        return 0;
+    }
 
-        #ifndef ENABLE_FEAT_F4HWN
-            #ifdef ENABLE_AM_FIX
-                case MENU_AM_FIX:
-            #endif
-        #endif
-        #ifdef ENABLE_AUDIO_BAR
-            case MENU_MIC_BAR:
-        #endif
-        case MENU_BCL:
-        case MENU_BEEP:
-        case MENU_S_ADD1:
-        case MENU_S_ADD2:
-        case MENU_S_ADD3:
-        case MENU_STE:
-        case MENU_D_ST:
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-#endif
-        case MENU_D_LIVE_DEC:
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-        #endif
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-        case MENU_200TX:
-        case MENU_500TX:
-#endif
-        case MENU_350EN:
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCREN:
-#endif
-#ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_TMR:
-#endif
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_OFF_ON) - 1;
-            break;
-        case MENU_AM:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gModulationStr) - 1;
-            break;
+    *pMin = 0;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCR:
+    switch (menu_id)
+    {
+        case MENU_F1SHRT:
+        case MENU_F1LONG:
+        case MENU_F2SHRT:
+        case MENU_F2LONG:
+        case MENU_MLONG:
             //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SCRAMBLER) - 1;
+            *pMax = gSubMenu_SIDEFUNCTIONS_size-1;
             break;
-#endif
 
-        case MENU_AUTOLK:
-            *pMax = 40;
-            break;
+        default:
+            return -1;
+    }
 
-        case MENU_TOT:
-            //*pMin = 0;
-            *pMin = 5;
-            *pMax = 179;
-            break;
+    return 0;
+}
 
-        #ifdef ENABLE_VOX
-            case MENU_VOX:
-        #endif
-        case MENU_RP_STE:
-            //*pMin = 0;
-            *pMax = 10;
+// the extra work some of the descriptor driven settings need once stored
+static void MENU_SettingChanged(const uint8_t menu_id)
+{
+    switch (menu_id)
+    {
+        default:
             break;
 
-        case MENU_MEM_CH:
-        case MENU_1_CALL:
-        case MENU_DEL_CH:
-        case MENU_MEM_NAME:
-            //*pMin = 0;
-            *pMax = MR_CHANNEL_LAST;
+        case MENU_ABR_MIN:
+            gEeprom.BACKLIGHT_MAX = MAX(gSubMenuSelection + 1 , gEeprom.BACKLIGHT_MAX);
             break;
 
-        case MENU_SLIST1:
-        case MENU_SLIST2:
-        case MENU_SLIST3:
-            *pMin = -1;
-            *pMax = MR_CHANNEL_LAST;
+        case MENU_ABR_MAX:
+            gEeprom.BACKLIGHT_MIN = MIN(gSubMenuSelection - 1, gEeprom.BACKLIGHT_MIN);
             break;
 
-        case MENU_SAVE:
-            //*pMin = 0;
-            *pMax = 5;
+        case MENU_AUTOLK:
+            gKeyLockCountdown = gEeprom.AUTO_KEYPAD_LOCK * 30; // 15 seconds step
             break;
 
         case MENU_MIC:
-            //*pMin = 0;
-            *pMax = 4;
-            break;
-
-        case MENU_S_LIST:
-            //*pMin = 0;
-            *pMax = 5;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_D_RSP) - 1;
-            break;
-#endif
-        case MENU_PTT_ID:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_PTT_ID) - 1;
-            break;
-
-        case MENU_BAT_TXT:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_BAT_TXT) - 1;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_HOLD:
-            *pMin = 5;
-            *pMax = 60;
-            break;
-#endif
-        case MENU_D_PRE:
-            *pMin = 3;
-            *pMax = 99;
+            SETTINGS_LoadCalibration();
             break;
 
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_LIST:
-            *pMin = 1;
-            *pMax = 16;
-            break;
-#endif
-        #ifdef ENABLE_F_CAL_MENU
-            case MENU_F_CALI:
-                *pMin = -50;
-                *pMax = +50;
+        #ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
+            case MENU_S_LIST:
+                gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E78);
                 break;
         #endif
 
-        case MENU_BATCAL:
-            *pMin = 1600;
-            *pMax = 2200;
-            break;
-
-        case MENU_BATTYP:
-            //*pMin = 0;
-            *pMax = 2;
-            break;
-
-#ifdef ENABLE_CW
-        case MENU_CW_ENABLED:
-            *pMax = 1;
-            break;
-        case MENU_CW_WPM:
-            *pMin = 5;
-            *pMax = 50;
-            break;
-        case MENU_CW_TONE:
-            *pMin = 300;
-            *pMax = 1200;
-            break;
-        case MENU_CW_MODE:
-            *pMax = ARRAY_SIZE(gSubMenu_CW_MODE) - 1;
+#ifdef ENABLE_DTMF_CALLING
+        case MENU_D_DCD:
+            DTMF_clear_RX();
             break;
-        case MENU_CW_MSG1:
-        case MENU_CW_MSG2:
-            return -1;
-		case MENU_CW_FMCW:
-			*pMax = ARRAY_SIZE(gSubMenu_CW_TX_Mode) - 1;
-			break;
-		case MENU_CW_WN:
-			*pMax = ARRAY_SIZE(gSubMenu_W_N) - 1;
-			break;
-		case MENU_CW_ID:
-		case MENU_CW_GRID:
-			return -1;
-		case MENU_CW_EOT:
-		case MENU_CW_T_HUNT:
-			*pMax = 1;
-			break;
-		case MENU_CW_SOS:
-#ifdef ENABLE_SOS
-			*pMax = 1;
-#else
-			return -1;
-#endif
-			break;
-		case MENU_CW_PIP_CNT:
-			*pMin = 1;
-			*pMax = 20;
-			break;
-		case MENU_CW_PIP_INT:
-			*pMin = 1;
-			*pMax = 60;
-			break;
-		case MENU_CW_ID_INT:
-			*pMin = 1;
-			*pMax = 60;
-			break;
 #endif
 
-        case MENU_F1SHRT:
-        case MENU_F1LONG:
-        case MENU_F2SHRT:
-        case MENU_F2LONG:
-        case MENU_MLONG:
-            //*pMin = 0;
-            *pMax = gSubMenu_SIDEFUNCTIONS_size-1;
+        case MENU_D_LIVE_DEC:
+            gDTMF_RX_live_timeout = 0;
+            memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
+            if (!gSetting_live_DTMF_decoder)
+                BK4819_DisableDTMF();
             break;
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP 
-        case MENU_SET_OFF:
-            *pMax = 120;
-            break;
-#endif
-
 #ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            *pMax = ARRAY_SIZE(gSubMenu_SET_PWR) - 1;
-            break;
-        case MENU_SET_PTT:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SET_PTT) - 1;
-            break;
-        case MENU_SET_TOT:
-        case MENU_SET_EOT:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SET_TOT) - 1;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            *pMin = 1;
-            *pMax = 15;
-            break;
-#endif
-        case MENU_TX_LOCK:
-#ifdef ENABLE_FEAT_F4HWN_INV
-        case MENU_SET_INV:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_OFF_ON) - 1;
-            break;
-#endif
-        case MENU_SET_LCK:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SET_LCK) - 1;
-            break;
-        case MENU_SET_MET:
-        case MENU_SET_GUI:
-            //*pMin = 0;
-            *pMax = ARRAY_SIZE(gSubMenu_SET_MET) - 1;
-            break;
         #ifdef ENABLE_FEAT_F4HWN_NARROWER
             case MENU_SET_NFM:
-                //*pMin = 0;
-                *pMax = ARRAY_SIZE(gSubMenu_SET_NFM) - 1;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                //*pMin = 0;
-                *pMax = 63;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
-            case MENU_SET_KEY:
-                //*pMin = 0;
-                *pMax = 4;
+                RADIO_SetTxParameters();
+                RADIO_SetupRegisters(true);
                 break;
         #endif
 #endif
-
-        default:
-            return -1;
     }
-
-    return 0;
 }
 
 void MENU_AcceptSetting(void)
 {
-    int32_t        Min;
-    int32_t        Max;
-    FREQ_Config_t *pConfig = &gTxVfo->freq_config_RX;
+    const uint8_t         menu_id  = UI_MENU_GetCurrentMenuId();
+    const menu_setting_t *pSetting = MENU_GetSetting(menu_id);
+    int32_t               Min;
+    int32_t               Max;
+    FREQ_Config_t        *pConfig  = &gTxVfo->freq_config_RX;
 
-    if (!MENU_GetLimits(UI_MENU_GetCurrentMenuId(), &Min, &Max))
+    if (!MENU_GetLimits(menu_id, &Min, &Max))
     {
         if (gSubMenuSelection < Min) gSubMenuSelection = Min;
         else
         if (gSubMenuSelection > Max) gSubMenuSelection = Max;
     }
 
-    switch (UI_MENU_GetCurrentMenuId())
+    if (MENU_HasStorage(pSetting))
+    {
+        MENU_WriteSetting(pSetting, gSubMenuSelection);
+        MENU_SettingChanged(menu_id);
+        return;
+    }
+
+    switch (menu_id)
     {
         default:
             return;
 
-        case MENU_SQL:
-            gEeprom.SQUELCH_LEVEL = gSubMenuSelection;
-            gVfoConfigureMode     = VFO_CONFIGURE;
-            break;
-
         case MENU_STEP:
             gTxVfo->STEP_SETTING = FREQUENCY_GetStepIdxFromSortedIdx(gSubMenuSelection);
             if (IS_FREQ_CHANNEL(gTxVfo->CHANNEL_SAVE))
@@ -535,11 +441,6 @@ void MENU_AcceptSetting(void)
             }
             return;
 
-        case MENU_TXP:
-            gTxVfo->OUTPUT_POWER = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            return;
-
         case MENU_T_DCS:
             pConfig = &gTxVfo->freq_config_TX;
 
@@ -584,39 +485,12 @@ void MENU_AcceptSetting(void)
             gRequestSaveChannel = 1;
             return;
         }
-        case MENU_SFT_D:
-            gTxVfo->TX_OFFSET_FREQUENCY_DIRECTION = gSubMenuSelection;
-            gRequestSaveChannel                   = 1;
-            return;
 
         case MENU_OFFSET:
             gTxVfo->TX_OFFSET_FREQUENCY = gSubMenuSelection;
             gRequestSaveChannel         = 1;
             return;
 
-        case MENU_W_N:
-            gTxVfo->CHANNEL_BANDWIDTH = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
-            return;
-
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCR:
-            gTxVfo->SCRAMBLING_TYPE = gSubMenuSelection;
-            #if 0
-                if (gSubMenuSelection > 0 && gSetting_ScrambleEnable)
-                    BK4819_EnableScramble(gSubMenuSelection - 1);
-                else
-                    BK4819_DisableScramble();
-            #endif
-            gRequestSaveChannel     = 1;
-            return;
-#endif
-
-        case MENU_BCL:
-            gTxVfo->BUSY_CHANNEL_LOCK = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
-            return;
-
         case MENU_MEM_CH:
             gTxVfo->CHANNEL_SAVE = gSubMenuSelection;
             #if 0
@@ -639,190 +513,45 @@ void MENU_AcceptSetting(void)
             SETTINGS_SaveChannelName(gSubMenuSelection, edit);
             return;
 
-        case MENU_SAVE:
-            gEeprom.BATTERY_SAVE = gSubMenuSelection;
-            break;
-
         #ifdef ENABLE_VOX
             case MENU_VOX:
                 gEeprom.VOX_SWITCH = gSubMenuSelection != 0;
                 if (gEeprom.VOX_SWITCH)
                     gEeprom.VOX_LEVEL = gSubMenuSelection - 1;
-                SETTINGS_LoadCalibration();
-                gFlagReconfigureVfos = true;
-                gUpdateStatus        = true;
-                break;
-        #endif
-
-        case MENU_ABR:
-            gEeprom.BACKLIGHT_TIME = gSubMenuSelection;
-            #ifdef ENABLE_FEAT_F4HWN
-                gBackLight = false;
-            #endif
-            break;
-
-        case MENU_ABR_MIN:
-            gEeprom.BACKLIGHT_MIN = gSubMenuSelection;
-            gEeprom.BACKLIGHT_MAX = MAX(gSubMenuSelection + 1 , gEeprom.BACKLIGHT_MAX);
-            break;
-
-        case MENU_ABR_MAX:
-            gEeprom.BACKLIGHT_MAX = gSubMenuSelection;
-            gEeprom.BACKLIGHT_MIN = MIN(gSubMenuSelection - 1, gEeprom.BACKLIGHT_MIN);
-            break;
-
-        case MENU_ABR_ON_TX_RX:
-            gSetting_backlight_on_tx_rx = gSubMenuSelection;
-            break;
-
-        case MENU_TDR:
-            gEeprom.DUAL_WATCH = (gEeprom.TX_VFO + 1) * (gSubMenuSelection & 1);
-            gEeprom.CROSS_BAND_RX_TX = (gEeprom.TX_VFO + 1) * ((gSubMenuSelection & 2) > 0);
-
-            #ifdef ENABLE_FEAT_F4HWN
-                gDW = gEeprom.DUAL_WATCH;
-                gCB = gEeprom.CROSS_BAND_RX_TX;
-                gSaveRxMode = true;
-            #endif
-
-            gFlagReconfigureVfos = true;
-            gUpdateStatus        = true;
-            break;
-
-        case MENU_BEEP:
-            gEeprom.BEEP_CONTROL = gSubMenuSelection;
-            break;
-
-        case MENU_TOT:
-            gEeprom.TX_TIMEOUT_TIMER = gSubMenuSelection;
-            break;
-
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                gEeprom.VOICE_PROMPT = gSubMenuSelection;
-                gUpdateStatus        = true;
-                break;
-        #endif
-
-        case MENU_SC_REV:
-            gEeprom.SCAN_RESUME_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_MDF:
-            gEeprom.CHANNEL_DISPLAY_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_AUTOLK:
-            gEeprom.AUTO_KEYPAD_LOCK = gSubMenuSelection;
-            gKeyLockCountdown        = gEeprom.AUTO_KEYPAD_LOCK * 30; // 15 seconds step
-            break;
-
-        case MENU_S_ADD1:
-            gTxVfo->SCANLIST1_PARTICIPATION = gSubMenuSelection;
-            SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
-            gVfoConfigureMode = VFO_CONFIGURE;
-            gFlagResetVfos    = true;
-            return;
-
-        case MENU_S_ADD2:
-            gTxVfo->SCANLIST2_PARTICIPATION = gSubMenuSelection;
-            SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
-            gVfoConfigureMode = VFO_CONFIGURE;
-            gFlagResetVfos    = true;
-            return;
-
-        case MENU_S_ADD3:
-            gTxVfo->SCANLIST3_PARTICIPATION = gSubMenuSelection;
-            SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
-            gVfoConfigureMode = VFO_CONFIGURE;
-            gFlagResetVfos    = true;
-            return;
-
-        case MENU_STE:
-            gEeprom.TAIL_TONE_ELIMINATION = gSubMenuSelection;
-            break;
-
-        case MENU_RP_STE:
-            gEeprom.REPEATER_TAIL_TONE_ELIMINATION = gSubMenuSelection;
-            break;
-
-        case MENU_MIC:
-            gEeprom.MIC_SENSITIVITY = gSubMenuSelection;
-            SETTINGS_LoadCalibration();
-            gFlagReconfigureVfos = true;
-            break;
-
-        #ifdef ENABLE_AUDIO_BAR
-            case MENU_MIC_BAR:
-                gSetting_mic_bar = gSubMenuSelection;
-                break;
-        #endif
-
-        case MENU_COMPAND:
-            gTxVfo->Compander = gSubMenuSelection;
-            SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
-            gVfoConfigureMode = VFO_CONFIGURE;
-            gFlagResetVfos    = true;
-//          gRequestSaveChannel = 1;
-            return;
-
-        case MENU_1_CALL:
-            gEeprom.CHAN_1_CALL = gSubMenuSelection;
-            break;
-
-        case MENU_S_LIST:
-            gEeprom.SCAN_LIST_DEFAULT = gSubMenuSelection;
-            break;
-
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                gEeprom.ALARM_MODE = gSubMenuSelection;
-                break;
+                SETTINGS_LoadCalibration();
+                gFlagReconfigureVfos = true;
+                gUpdateStatus        = true;
+                gSettingsDirty      |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E70);
+                return;
         #endif
 
-        case MENU_D_ST:
-            gEeprom.DTMF_SIDE_TONE = gSubMenuSelection;
-            break;
+        case MENU_ABR:
+            gEeprom.BACKLIGHT_TIME = gSubMenuSelection;
+            #ifdef ENABLE_FEAT_F4HWN
+                gBackLight = false;
+            #endif
+            gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E78);
+            return;
 
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            gEeprom.DTMF_DECODE_RESPONSE = gSubMenuSelection;
-            break;
+        case MENU_TDR:
+            gEeprom.DUAL_WATCH = (gEeprom.TX_VFO + 1) * (gSubMenuSelection & 1);
+            gEeprom.CROSS_BAND_RX_TX = (gEeprom.TX_VFO + 1) * ((gSubMenuSelection & 2) > 0);
 
-        case MENU_D_HOLD:
-            gEeprom.DTMF_auto_reset_time = gSubMenuSelection;
-            break;
-#endif
-        case MENU_D_PRE:
-            gEeprom.DTMF_PRELOAD_TIME = gSubMenuSelection * 10;
-            break;
+            #ifdef ENABLE_FEAT_F4HWN
+                gDW = gEeprom.DUAL_WATCH;
+                gCB = gEeprom.CROSS_BAND_RX_TX;
+                gSaveRxMode = true;
+            #endif
 
-        case MENU_PTT_ID:
-            gTxVfo->DTMF_PTT_ID_TX_MODE = gSubMenuSelection;
-            gRequestSaveChannel         = 1;
+            gFlagReconfigureVfos = true;
+            gUpdateStatus        = true;
+            gSettingsDirty      |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E78);
             return;
 
-        case MENU_BAT_TXT:
-            gSetting_battery_text = gSubMenuSelection;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-            gTxVfo->DTMF_DECODING_ENABLE = gSubMenuSelection;
-            DTMF_clear_RX();
-            gRequestSaveChannel = 1;
+        case MENU_D_PRE:
+            gEeprom.DTMF_PRELOAD_TIME = gSubMenuSelection * 10;
+            gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0ED0);
             return;
-#endif
-
-        case MENU_D_LIVE_DEC:
-            gSetting_live_DTMF_decoder = gSubMenuSelection;
-            gDTMF_RX_live_timeout = 0;
-            memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
-            if (!gSetting_live_DTMF_decoder)
-                BK4819_DisableDTMF();
-            gFlagReconfigureVfos     = true;
-            gUpdateStatus            = true;
-            break;
 
 #ifdef ENABLE_DTMF_CALLING
         case MENU_D_LIST:
@@ -837,35 +566,6 @@ void MENU_AcceptSetting(void)
             }
             return;
 #endif
-        case MENU_PONMSG:
-            gEeprom.POWER_ON_DISPLAY_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_ROGER:
-            gEeprom.ROGER = gSubMenuSelection;
-            break;
-
-        case MENU_AM:
-            gTxVfo->Modulation     = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            return;
-
-        #ifndef ENABLE_FEAT_F4HWN
-            #ifdef ENABLE_AM_FIX
-                case MENU_AM_FIX:
-                    gSetting_AM_fix = gSubMenuSelection;
-                    gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
-                    gFlagResetVfos    = true;
-                    break;
-            #endif
-        #endif
-
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-                gEeprom.NOAA_AUTO_SCAN = gSubMenuSelection;
-                gFlagReconfigureVfos   = true;
-                break;
-        #endif
 
         case MENU_DEL_CH:
             SETTINGS_UpdateChannel(gSubMenuSelection, NULL, false, false, true);
@@ -877,12 +577,6 @@ void MENU_AcceptSetting(void)
             SETTINGS_FactoryReset(gSubMenuSelection);
             return;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-            gSetting_350TX = gSubMenuSelection;
-            break;
-#endif
-
         case MENU_F_LOCK: {
             if(gSubMenuSelection == F_LOCK_NONE) { // select 10 times to enable
                 gUnlockAllTxConfCnt++;
@@ -903,28 +597,9 @@ void MENU_AcceptSetting(void)
                 SETTINGS_ResetTxLock();
             }
             #endif
-            break;
+            gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0F40);
+            return;
         }
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_200TX:
-            gSetting_200TX = gSubMenuSelection;
-            break;
-
-        case MENU_500TX:
-            gSetting_500TX = gSubMenuSelection;
-            break;
-#endif
-        case MENU_350EN:
-            gSetting_350EN       = gSubMenuSelection;
-            gVfoConfigureMode    = VFO_CONFIGURE_RELOAD;
-            gFlagResetVfos       = true;
-            break;
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCREN:
-            gSetting_ScrambleEnable = gSubMenuSelection;
-            gFlagReconfigureVfos    = true;
-            break;
-#endif
 
         #ifdef ENABLE_F_CAL_MENU
             case MENU_F_CALI:
@@ -944,10 +619,6 @@ void MENU_AcceptSetting(void)
             return;
         }
 
-        case MENU_BATTYP:
-            gEeprom.BATTERY_TYPE = gSubMenuSelection;
-            break;
-
         case MENU_F1SHRT:
         case MENU_F1LONG:
         case MENU_F2SHRT:
@@ -960,91 +631,24 @@ void MENU_AcceptSetting(void)
                     &gEeprom.KEY_2_SHORT_PRESS_ACTION,
                     &gEeprom.KEY_2_LONG_PRESS_ACTION,
                     &gEeprom.KEY_M_LONG_PRESS_ACTION};
-                *fun[UI_MENU_GetCurrentMenuId()-MENU_F1SHRT] = gSubMenu_SIDEFUNCTIONS[gSubMenuSelection].id;
+                *fun[menu_id - MENU_F1SHRT] = gSubMenu_SIDEFUNCTIONS[gSubMenuSelection].id;
             }
-            break;
-
-#ifdef ENABLE_FEAT_F4HWN_SLEEP 
-        case MENU_SET_OFF:
-            gSetting_set_off = gSubMenuSelection;
-            break;
-#endif
+            gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E90);
+            return;
 
 #ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            gSetting_set_pwr = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            break;
         case MENU_SET_PTT:
             gSetting_set_ptt = gSubMenuSelection;
             gSetting_set_ptt_session = gSetting_set_ptt; // Special for action
-            break;
-        case MENU_SET_TOT:
-            gSetting_set_tot = gSubMenuSelection;
-            break;
-        case MENU_SET_EOT:
-            gSetting_set_eot = gSubMenuSelection;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            gSetting_set_ctr = gSubMenuSelection;
-            break;
-#endif
-        case MENU_SET_INV:
-            gSetting_set_inv = gSubMenuSelection;
-            break;
-        case MENU_SET_LCK:
-            gSetting_set_lck = gSubMenuSelection;
-            break;
-        case MENU_SET_MET:
-            gSetting_set_met = gSubMenuSelection;
-            break;
-        case MENU_SET_GUI:
-            gSetting_set_gui = gSubMenuSelection;
-            break;
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                gSetting_set_nfm = gSubMenuSelection;
-                RADIO_SetTxParameters();
-                RADIO_SetupRegisters(true);
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                gEeprom.VOLUME_GAIN = gSubMenuSelection;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
-            case MENU_SET_KEY:
-                gEeprom.SET_KEY = gSubMenuSelection;
-                break;
-        #endif
-        case MENU_SET_TMR:
-            gSetting_set_tmr = gSubMenuSelection;
-            break;
-        case MENU_TX_LOCK:
-            gTxVfo->TX_LOCK = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
+            gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_1FF0);
             return;
 #endif
 
 #ifdef ENABLE_CW
-		case MENU_CW_ENABLED:
-			gCWSettings.enabled = gSubMenuSelection;
-			break;
-		case MENU_CW_WPM:
-			gCWSettings.wpm = gSubMenuSelection;
-			break;
-		case MENU_CW_TONE:
-			gCWSettings.tone_hz = gSubMenuSelection;
-			break;
-		case MENU_CW_MODE:
-			gCWSettings.mode = gSubMenuSelection;
-			break;
 		case MENU_CW_MSG1:
 		case MENU_CW_MSG2:
 			{
-				const uint8_t msg_index = (UI_MENU_GetCurrentMenuId() == MENU_CW_MSG1) ? 0 : 1;
+				const uint8_t msg_index = (menu_id == MENU_CW_MSG1) ? 0 : 1;
 				for (int i = 15; i >= 0; i--)
 				{
 					if (edit[i] != ' ' && edit[i] != '_' && edit[i] != 0x00 && edit[i] != 0xff)
@@ -1053,17 +657,12 @@ void MENU_AcceptSetting(void)
 				}
 				strcpy(gCWSettings.messages[msg_index], edit);
 			}
-			break;
-		case MENU_CW_FMCW:
-			gCWSettings.tx_mode = gSubMenuSelection;
-			break;
-		case MENU_CW_WN:
-			gCWSettings.bandwidth = gSubMenuSelection;
-			break;
+			gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_CW);
+			return;
 		case MENU_CW_ID:
 		case MENU_CW_GRID:
 			{
-				char *pStr = (UI_MENU_GetCurrentMenuId() == MENU_CW_ID) ? gCWSettings.callsign : gCWSettings.grid_square;
+				char *pStr = (menu_id == MENU_CW_ID) ? gCWSettings.callsign : gCWSettings.grid_square;
 				const uint8_t max_len = 10;
 				for (int i = max_len - 1; i >= 0; i--)
 				{
@@ -1073,32 +672,10 @@ void MENU_AcceptSetting(void)
 				}
 				strcpy(pStr, edit);
 			}
-			break;
-		case MENU_CW_EOT:
-			gCWSettings.eot_enabled = gSubMenuSelection;
-			break;
-		case MENU_CW_T_HUNT:
-			// T-Hunt
-			gCWSettings.fox_hunt_enabled = gSubMenuSelection;
-			break;
-		case MENU_CW_SOS:
-#ifdef ENABLE_SOS
-			gCWSettings.sos_mode_enabled = gSubMenuSelection;
-#endif
-			break;
-		case MENU_CW_PIP_CNT:
-			gCWSettings.pip_count = gSubMenuSelection;
-			break;
-		case MENU_CW_PIP_INT:
-			gCWSettings.pip_interval = gSubMenuSelection;
-			break;
-		case MENU_CW_ID_INT:
-			gCWSettings.id_interval = gSubMenuSelection;
-			break;
+			gSettingsDirty |= SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_CW);
+			return;
 #endif
     }
-
-    gRequestSaveSettings = true;
 }
 
 static void MENU_ClampSelection(int8_t Direction)
@@ -1118,20 +695,21 @@ static void MENU_ClampSelection(int8_t Direction)
 
 void MENU_ShowCurrentSetting(void)
 {
-    switch (UI_MENU_GetCurrentMenuId())
+    const uint8_t         menu_id  = UI_MENU_GetCurrentMenuId();
+    const menu_setting_t *pSetting = MENU_GetSetting(menu_id);
+
+    if (MENU_HasStorage(pSetting))
     {
-        case MENU_SQL:
-            gSubMenuSelection = gEeprom.SQUELCH_LEVEL;
-            break;
+        gSubMenuSelection = MENU_ReadSetting(pSetting);
+        return;
+    }
 
+    switch (menu_id)
+    {
         case MENU_STEP:
             gSubMenuSelection = FREQUENCY_GetSortedIdxFromStepIdx(gTxVfo->STEP_SETTING);
             break;
 
-        case MENU_TXP:
-            gSubMenuSelection = gTxVfo->OUTPUT_POWER;
-            break;
-
         case MENU_RESET:
             gSubMenuSelection = 0;
             break;
@@ -1141,14 +719,13 @@ void MENU_ShowCurrentSetting(void)
         {
             DCS_CodeType_t type = gTxVfo->freq_config_RX.CodeType;
             uint8_t code = gTxVfo->freq_config_RX.Code;
-            int menuid = UI_MENU_GetCurrentMenuId();
 
             if(gScanUseCssResult) {
                 gScanUseCssResult = false;
                 type = gScanCssResultType;
                 code = gScanCssResultCode;
             }
-            if((menuid==MENU_R_CTCS) ^ (type==CODE_TYPE_CONTINUOUS_TONE)) { //not the same type
+            if((menu_id==MENU_R_CTCS) ^ (type==CODE_TYPE_CONTINUOUS_TONE)) { //not the same type
                 gSubMenuSelection = 0;
                 break;
             }
@@ -1187,28 +764,10 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = (gTxVfo->freq_config_TX.CodeType == CODE_TYPE_CONTINUOUS_TONE) ? gTxVfo->freq_config_TX.Code + 1 : 0;
             break;
 
-        case MENU_SFT_D:
-            gSubMenuSelection = gTxVfo->TX_OFFSET_FREQUENCY_DIRECTION;
-            break;
-
         case MENU_OFFSET:
             gSubMenuSelection = gTxVfo->TX_OFFSET_FREQUENCY;
             break;
 
-        case MENU_W_N:
-            gSubMenuSelection = gTxVfo->CHANNEL_BANDWIDTH;
-            break;
-
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCR:
-            gSubMenuSelection = gTxVfo->SCRAMBLING_TYPE;
-            break;
-#endif
-
-        case MENU_BCL:
-            gSubMenuSelection = gTxVfo->BUSY_CHANNEL_LOCK;
-            break;
-
         case MENU_MEM_CH:
             #if 0
                 gSubMenuSelection = gEeprom.MrChannel[0];
@@ -1221,10 +780,6 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gEeprom.MrChannel[gEeprom.TX_VFO];
             break;
 
-        case MENU_SAVE:
-            gSubMenuSelection = gEeprom.BATTERY_SAVE;
-            break;
-
 #ifdef ENABLE_VOX
         case MENU_VOX:
             gSubMenuSelection = gEeprom.VOX_SWITCH ? gEeprom.VOX_LEVEL + 1 : 0;
@@ -1246,165 +801,25 @@ void MENU_ShowCurrentSetting(void)
             #endif
             break;
 
-        case MENU_ABR_MIN:
-            gSubMenuSelection = gEeprom.BACKLIGHT_MIN;
-            break;
-
-        case MENU_ABR_MAX:
-            gSubMenuSelection = gEeprom.BACKLIGHT_MAX;
-            break;
-
-        case MENU_ABR_ON_TX_RX:
-            gSubMenuSelection = gSetting_backlight_on_tx_rx;
-            break;
-
         case MENU_TDR:
             gSubMenuSelection = (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF) + (gEeprom.CROSS_BAND_RX_TX != CROSS_BAND_OFF) * 2;
             break;
 
-        case MENU_BEEP:
-            gSubMenuSelection = gEeprom.BEEP_CONTROL;
-            break;
-
-        case MENU_TOT:
-            gSubMenuSelection = gEeprom.TX_TIMEOUT_TIMER;
-            break;
-
-#ifdef ENABLE_VOICE
-        case MENU_VOICE:
-            gSubMenuSelection = gEeprom.VOICE_PROMPT;
-            break;
-#endif
-
-        case MENU_SC_REV:
-            gSubMenuSelection = gEeprom.SCAN_RESUME_MODE;
-            break;
-
-        case MENU_MDF:
-            gSubMenuSelection = gEeprom.CHANNEL_DISPLAY_MODE;
-            break;
-
-        case MENU_AUTOLK:
-            gSubMenuSelection = gEeprom.AUTO_KEYPAD_LOCK;
-            break;
-
-        case MENU_S_ADD1:
-            gSubMenuSelection = gTxVfo->SCANLIST1_PARTICIPATION;
-            break;
-
-        case MENU_S_ADD2:
-            gSubMenuSelection = gTxVfo->SCANLIST2_PARTICIPATION;
-            break;
-
-        case MENU_S_ADD3:
-            gSubMenuSelection = gTxVfo->SCANLIST3_PARTICIPATION;
-            break;
-
-        case MENU_STE:
-            gSubMenuSelection = gEeprom.TAIL_TONE_ELIMINATION;
-            break;
-
-        case MENU_RP_STE:
-            gSubMenuSelection = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
-            break;
-
-        case MENU_MIC:
-            gSubMenuSelection = gEeprom.MIC_SENSITIVITY;
-            break;
-
-#ifdef ENABLE_AUDIO_BAR
-        case MENU_MIC_BAR:
-            gSubMenuSelection = gSetting_mic_bar;
-            break;
-#endif
-
-        case MENU_COMPAND:
-            gSubMenuSelection = gTxVfo->Compander;
-            return;
-
-        case MENU_1_CALL:
-            gSubMenuSelection = gEeprom.CHAN_1_CALL;
-            break;
-
-        case MENU_S_LIST:
-            gSubMenuSelection = gEeprom.SCAN_LIST_DEFAULT;
-            break;
-
         case MENU_SLIST1:
         case MENU_SLIST2:
         case MENU_SLIST3:
-            gSubMenuSelection = RADIO_FindNextChannel(0, 1, true, UI_MENU_GetCurrentMenuId() - MENU_SLIST1 + 1);
-            break;
-
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                gSubMenuSelection = gEeprom.ALARM_MODE;
-                break;
-        #endif
-
-        case MENU_D_ST:
-            gSubMenuSelection = gEeprom.DTMF_SIDE_TONE;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            gSubMenuSelection = gEeprom.DTMF_DECODE_RESPONSE;
+            gSubMenuSelection = RADIO_FindNextChannel(0, 1, true, menu_id - MENU_SLIST1 + 1);
             break;
 
-        case MENU_D_HOLD:
-            gSubMenuSelection = gEeprom.DTMF_auto_reset_time;
-            break;
-#endif
         case MENU_D_PRE:
             gSubMenuSelection = gEeprom.DTMF_PRELOAD_TIME / 10;
             break;
 
-        case MENU_PTT_ID:
-            gSubMenuSelection = gTxVfo->DTMF_PTT_ID_TX_MODE;
-            break;
-
-        case MENU_BAT_TXT:
-            gSubMenuSelection = gSetting_battery_text;
-            return;
-
 #ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-            gSubMenuSelection = gTxVfo->DTMF_DECODING_ENABLE;
-            break;
-
         case MENU_D_LIST:
             gSubMenuSelection = gDTMF_chosen_contact + 1;
             break;
 #endif
-        case MENU_D_LIVE_DEC:
-            gSubMenuSelection = gSetting_live_DTMF_decoder;
-            break;
-
-        case MENU_PONMSG:
-            gSubMenuSelection = gEeprom.POWER_ON_DISPLAY_MODE;
-            break;
-
-        case MENU_ROGER:
-            gSubMenuSelection = gEeprom.ROGER;
-            break;
-
-        case MENU_AM:
-            gSubMenuSelection = gTxVfo->Modulation;
-            break;
-
-#ifndef ENABLE_FEAT_F4HWN
-    #ifdef ENABLE_AM_FIX
-            case MENU_AM_FIX:
-                gSubMenuSelection = gSetting_AM_fix;
-                break;
-    #endif
-#endif
-                
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-                gSubMenuSelection = gEeprom.NOAA_AUTO_SCAN;
-                break;
-        #endif
 
         case MENU_DEL_CH:
             #if 0
@@ -1414,36 +829,10 @@ void MENU_ShowCurrentSetting(void)
             #endif
             break;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-            gSubMenuSelection = gSetting_350TX;
-            break;
-#endif
-
         case MENU_F_LOCK:
             gSubMenuSelection = gSetting_F_LOCK;
             break;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_200TX:
-            gSubMenuSelection = gSetting_200TX;
-            break;
-
-        case MENU_500TX:
-            gSubMenuSelection = gSetting_500TX;
-            break;
-
-#endif
-        case MENU_350EN:
-            gSubMenuSelection = gSetting_350EN;
-            break;
-
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCREN:
-            gSubMenuSelection = gSetting_ScrambleEnable;
-            break;
-#endif
-
         #ifdef ENABLE_F_CAL_MENU
             case MENU_F_CALI:
                 gSubMenuSelection = gEeprom.BK4819_XTAL_FREQ_LOW;
@@ -1454,55 +843,6 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gBatteryCalibration[3];
             break;
 
-        case MENU_BATTYP:
-            gSubMenuSelection = gEeprom.BATTERY_TYPE;
-            break;
-
-#ifdef ENABLE_CW
-        case MENU_CW_ENABLED:
-            gSubMenuSelection = gCWSettings.enabled;
-            break;
-        case MENU_CW_WPM:
-            gSubMenuSelection = gCWSettings.wpm;
-            break;
-        case MENU_CW_TONE:
-            gSubMenuSelection = gCWSettings.tone_hz;
-            break;
-        case MENU_CW_MODE:
-            gSubMenuSelection = gCWSettings.mode;
-            break;
-        case MENU_CW_MSG1:
-        case MENU_CW_MSG2:
-            break;
-		case MENU_CW_FMCW:
-			gSubMenuSelection = gCWSettings.tx_mode;
-			break;
-		case MENU_CW_WN:
-			gSubMenuSelection = gCWSettings.bandwidth;
-			break;
-		case MENU_CW_ID:
-		case MENU_CW_GRID:
-			break;
-		case MENU_CW_EOT:
-			gSubMenuSelection = gCWSettings.eot_enabled;
-			break;
-		case MENU_CW_T_HUNT:
-			gSubMenuSelection = gCWSettings.fox_hunt_enabled;
-			break;
-		case MENU_CW_SOS:
-			gSubMenuSelection = gCWSettings.sos_mode_enabled;
-			break;
-		case MENU_CW_PIP_CNT:
-			gSubMenuSelection = gCWSettings.pip_count;
-			break;
-		case MENU_CW_PIP_INT:
-			gSubMenuSelection = gCWSettings.pip_interval;
-			break;
-		case MENU_CW_ID_INT:
-			gSubMenuSelection = gCWSettings.id_interval;
-			break;
-#endif
-
         case MENU_F1SHRT:
         case MENU_F1LONG:
         case MENU_F2SHRT:
@@ -1515,7 +855,7 @@ void MENU_ShowCurrentSetting(void)
                 &gEeprom.KEY_2_SHORT_PRESS_ACTION,
                 &gEeprom.KEY_2_LONG_PRESS_ACTION,
                 &gEeprom.KEY_M_LONG_PRESS_ACTION};
-            uint8_t id = *fun[UI_MENU_GetCurrentMenuId()-MENU_F1SHRT];
+            uint8_t id = *fun[menu_id - MENU_F1SHRT];
 
             for(int i = 0; i < gSubMenu_SIDEFUNCTIONS_size; i++) {
                 if(gSubMenu_SIDEFUNCTIONS[i].id==id) {
@@ -1528,63 +868,10 @@ void MENU_ShowCurrentSetting(void)
             break;
         }
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP 
-        case MENU_SET_OFF:
-            gSubMenuSelection = gSetting_set_off;
-            break;
-#endif
-
 #ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            gSubMenuSelection = gSetting_set_pwr;
-            break;
         case MENU_SET_PTT:
             gSubMenuSelection = gSetting_set_ptt_session;
             break;
-        case MENU_SET_TOT:
-            gSubMenuSelection = gSetting_set_tot;
-            break;
-        case MENU_SET_EOT:
-            gSubMenuSelection = gSetting_set_eot;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            gSubMenuSelection = gSetting_set_ctr;
-            break;
-#endif
-        case MENU_SET_INV:
-            gSubMenuSelection = gSetting_set_inv;
-            break;
-        case MENU_SET_LCK:
-            gSubMenuSelection = gSetting_set_lck;
-            break;
-        case MENU_SET_MET:
-            gSubMenuSelection = gSetting_set_met;
-            break;
-        case MENU_SET_GUI:
-            gSubMenuSelection = gSetting_set_gui;
-            break;
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                gSubMenuSelection = gSetting_set_nfm;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                gSubMenuSelection = gEeprom.VOLUME_GAIN;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
-            case MENU_SET_KEY:
-                gSubMenuSelection = gEeprom.SET_KEY;
-                break;
-        #endif
-        case MENU_SET_TMR:
-            gSubMenuSelection = gSetting_set_tmr;
-            break;
-        case MENU_TX_LOCK:
-            gSubMenuSelection = gTxVfo->TX_LOCK;
-            break;
 #endif
 
         default:
@@ -17,6 +17,8 @@
 #ifndef APP_MENU_H
 #define APP_MENU_H
 
+#include <stdint.h>
+
 #include "driver/keyboard.h"
 
 #ifdef ENABLE_F_CAL_MENU
@@ -25,6 +27,59 @@
 
 extern uint8_t gUnlockAllTxConfCnt;
 
+// descriptor of a menu entry, indexed by its MENU_* id
+//
+// a plain setting is moved between gSubMenuSelection and its storage by
+// MENU_ShowCurrentSetting() and MENU_AcceptSetting() straight from here and
+// marks its eeprom block dirty, menus that need more keep a case of their own
+typedef struct {
+    void    *storage;   // the setting, NULL for a field of *gTxVfo or no storage
+    int16_t  min;       // limits, none when max <= min
+    int16_t  max;
+    uint8_t  offset;    // offsetof(VFO_Info_t, field) with MENU_F_VFO
+    uint8_t  flags;     // MENU_F_*
+    uint8_t  block;     // SETTINGS_Block_t the setting is saved in
+    uint8_t  format;    // MENU_FORMAT_*, how UI_DisplayMenu() shows the value
+} menu_setting_t;
+
+enum {
+    MENU_F_VFO            = 1u << 0,  // a field of the TX VFO
+    MENU_F_U16            = 1u << 1,  // 16 bit storage, 8 bit otherwise
+    MENU_F_SAVE_CHANNEL   = 1u << 2,  // save the channel
+    MENU_F_UPDATE_CHANNEL = 1u << 3,  // update the channel right away and reset the VFOs
+    MENU_F_VFO_CONFIGURE  = 1u << 4,  // configure the VFOs
+    MENU_F_VFO_RELOAD     = 1u << 5,  // reload and reset the VFOs
+    MENU_F_RECONFIGURE    = 1u << 6,  // reconfigure the VFOs
+    MENU_F_STATUS         = 1u << 7,  // redraw the status line
+};
+
+enum {
+    MENU_FORMAT_CUSTOM = 0,  // drawn by its own case in UI_DisplayMenu()
+    MENU_FORMAT_NUMBER,      // the value as is
+    MENU_FORMAT_OFF_ON,      // the rest are string lists indexed by the value
+    MENU_FORMAT_SFT_D,
+    MENU_FORMAT_W_N,
+    MENU_FORMAT_RX_TX,
+    MENU_FORMAT_VOICE,
+    MENU_FORMAT_AL_MOD,
+    MENU_FORMAT_D_RSP,
+    MENU_FORMAT_PONMSG,
+    MENU_FORMAT_ROGER,
+    MENU_FORMAT_BAT_TXT,
+    MENU_FORMAT_RESET,
+    MENU_FORMAT_BATTYP,
+    MENU_FORMAT_CW_MODE,
+    MENU_FORMAT_CW_TX_MODE,
+    MENU_FORMAT_SET_PTT,
+    MENU_FORMAT_SET_TOT,
+    MENU_FORMAT_SET_LCK,
+    MENU_FORMAT_SET_MET,
+    MENU_FORMAT_SET_NFM,
+    MENU_FORMAT_SET_KEY,
+};
+
+const menu_setting_t *MENU_GetSetting(uint8_t menu_id);
+
 int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax);
 void MENU_AcceptSetting(void);
 void MENU_ShowCurrentSetting(void);
@@ -17,6 +17,8 @@
 #include "am_fix.h"
 #include "audio.h"
 #include "misc.h"
+#include "sram-text.h"
+#include "trace.h"
 
 #ifdef ENABLE_SCAN_RANGES
 #include "chFrScanner.h"
@@ -64,7 +66,15 @@ State currentState = SPECTRUM, previousState = SPECTRUM;
 
 PeakInfo peak;
 ScanInfo scanInfo;
-KeyboardState kbd = {KEY_INVALID, KEY_INVALID, 0};
+static KEYBOARD_State_t kbd = {.Reading0 = KEY_INVALID, .Reading1 = KEY_INVALID};
+
+// first action after 20ms, then every 60ms once held for 300ms, the keypad keys only (not PTT/side keys)
+static const KEYBOARD_Timing_t kbdTiming = {
+    .Debounce_10ms = 20 / 10,
+    .Hold_10ms     = 300 / 10,
+    .Repeat_10ms   = 60 / 10,
+    .RepeatKeys    = (1u << KEY_PTT) - 1,
+};
 
 #ifdef ENABLE_SCAN_RANGES
 static uint16_t blacklistFreqs[15];
@@ -412,7 +422,7 @@ uint8_t GetBWRegValueForScan()
     return scanStepBWRegValues[settings.scanStepIndex];
 }
 
-uint16_t GetRssi()
+SRAM_TEXT uint16_t GetRssi()
 {
     // SYSTICK_DelayUs(800);
     // testing autodelay based on Glitch value
@@ -422,7 +432,7 @@ uint16_t GetRssi()
     }
     uint16_t rssi = BK4819_GetRSSI();
 #ifdef ENABLE_AM_FIX
-    if (settings.modulationType == MODULATION_AM && gSetting_AM_fix)
+    if (AM_fix_is_active(settings.modulationType))
         rssi += AM_fix_get_gain_diff() * 2;
 #endif
     return rssi;
@@ -1266,6 +1276,21 @@ void OnKeyDownStill(KEY_Code_t key)
     case KEY_6:
         ToggleListeningBW();
         break;
+#ifdef ENABLE_SOFT_AGC
+    case KEY_4:
+        // software AGC <-> gain locked where it is
+        if (lockAGC)
+        {
+            lockAGC = false;
+            RADIO_SetupAGC(settings.modulationType == MODULATION_AM, lockAGC);
+        }
+        else
+        {
+            LockAGC();
+        }
+        redrawScreen = true;
+        break;
+#endif
     case KEY_SIDE1:
         monitorMode = !monitorMode;
         break;
@@ -1360,6 +1385,10 @@ static void RenderStill()
     sprintf(String, "%d dBm", dbm);
     GUI_DisplaySmallest(String, 28, 25, false, true);
 
+#ifdef ENABLE_SOFT_AGC
+    GUI_DisplaySmallest(lockAGC ? "AGC LCK" : (AM_fix_is_active(settings.modulationType) ? "AGC SW" : "AGC HW"), 96, 25, false, true);
+#endif
+
     if (!monitorMode)
     {
         uint8_t x = Rssi2PX(settings.rssiTriggerLevel, 0, 121);
@@ -1438,35 +1467,44 @@ static void Render()
 
 bool HandleUserInput()
 {
-    kbd.prev = kbd.current;
-    kbd.current = GetKey();
+    static uint16_t pressTime_10ms;
+    KEY_Event_t     event;
 
-    if (kbd.current != KEY_INVALID && kbd.current == kbd.prev)
-    {
-        if (kbd.counter < 16)
-            kbd.counter++;
-        else
-            kbd.counter -= 3;
-        SYSTEM_DelayMs(20);
-    }
-    else
-    {
-        kbd.counter = 0;
-    }
+    KEYBOARD_Update(&kbd, GetKey(), &kbdTiming);
 
-    if (kbd.counter == 3 || kbd.counter == 16)
+    while (KEYBOARD_GetEvent(&event))
     {
-        switch (currentState)
+        uint8_t steps = 1;
+
+        if (event.Type == KEY_EVENT_RELEASE)
+            continue;
+
+        // the hold is the first repeat of a repeating key, the others already acted on the press
+        if (event.Type == KEY_EVENT_HOLD && !(kbdTiming.RepeatKeys & (1u << event.Key)))
+            continue;
+
+        if (event.Type == KEY_EVENT_PRESS)
+            pressTime_10ms = event.Time_10ms;
+
+        // UP/DOWN tune 5 steps per repeat once held for 2 seconds
+        if (event.Type == KEY_EVENT_REPEAT && (event.Key == KEY_UP || event.Key == KEY_DOWN) &&
+            (uint16_t)(event.Time_10ms - pressTime_10ms) >= 2000 / 10)
+            steps = 5;
+
+        while (steps--)
         {
-        case SPECTRUM:
-            OnKeyDown(kbd.current);
-            break;
-        case FREQ_INPUT:
-            OnKeyDownFreqInput(kbd.current);
-            break;
-        case STILL:
-            OnKeyDownStill(kbd.current);
-            break;
+            switch (currentState)
+            {
+            case SPECTRUM:
+                OnKeyDown(event.Key);
+                break;
+            case FREQ_INPUT:
+                OnKeyDownFreqInput(event.Key);
+                break;
+            case STILL:
+                OnKeyDownStill(event.Key);
+                break;
+            }
         }
     }
 
@@ -1494,7 +1532,7 @@ static void NextScanStep()
     scanInfo.f += scanInfo.scanStep;
 }
 
-static void UpdateScan()
+SRAM_TEXT static void UpdateScan()
 {
     Scan();
 
@@ -1574,16 +1612,23 @@ static void UpdateListening()
 
 static void Tick()
 {
-#ifdef ENABLE_AM_FIX
+    bool keysDue = false;
+
+#ifdef ENABLE_REG_TRACE
+    TRACE_Stream();
+#endif
+
     if (gNextTimeslice)
     {
         gNextTimeslice = false;
-        if (settings.modulationType == MODULATION_AM && !lockAGC)
+        keysDue = true;   // the keypad is read once per 10ms slice, the scan never waits on it
+#ifdef ENABLE_AM_FIX
+        if (!lockAGC)
         {
-            AM_fix_10ms(vfo); // allow AM_Fix to apply its AGC action
+            AM_fix_10ms(vfo, settings.modulationType); // allow AM_Fix to apply its AGC action
         }
-    }
 #endif
+    }
 
 #ifdef ENABLE_SCAN_RANGES
     if (gNextTimeslice_500ms)
@@ -1608,7 +1653,7 @@ static void Tick()
     }
 #endif
 
-    if (!preventKeypress)
+    if (keysDue && !preventKeypress)
     {
         HandleUserInput();
     }
@@ -1689,6 +1734,8 @@ void APP_RunSpectrum()
 
     BackupRegisters();
 
+    KEYBOARD_Reset(&kbd);
+
     isListening = true; // to turn off RX later
     redrawStatus = true;
     redrawScreen = true;
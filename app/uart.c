@@ -36,6 +36,10 @@
 #include "functions.h"
 #include "misc.h"
 #include "settings.h"
+#ifdef ENABLE_EXTRA_UART_CMD
+    #include "telemetry.h"
+#endif
+#include "trace.h"
 #include "version.h"
 
 #if defined(ENABLE_OVERLAY)
@@ -106,6 +110,24 @@ typedef struct {
     } Data;
 } REPLY_051D_t;
 
+typedef struct {
+    Header_t Header;
+    uint16_t Offset;
+    uint8_t  BlockSize;   // 1 to 128 bytes
+    uint8_t  Count;       // up to 64 blocks
+    uint32_t Timestamp;
+} CMD_0537_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint16_t Offset;
+        uint8_t  BlockSize;
+        uint8_t  Count;       // 0 when locked or out of range
+        uint16_t CRC[64];
+    } Data;
+} REPLY_0537_t;
+
 #ifdef ENABLE_EXTRA_UART_CMD
 typedef struct {
     Header_t Header;
@@ -128,6 +150,20 @@ typedef struct {
     Header_t Header;
     uint32_t Response[4];
 } CMD_052D_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint32_t FunctionTime_10ms[FUNCTION_N_ELEM];
+        uint32_t PowerSaveAwake_10ms;
+        uint16_t DutyCycle;             // 0.1% of power save time spent awake
+        uint16_t SleepWindow_10ms;
+        uint16_t Current_mA;
+        uint16_t Quiet_500ms;
+        uint16_t Remaining_mAh;         // 0 while unknown or charging
+        uint16_t RemainingMinutes;
+    } Data;
+} REPLY_0531_t;
 #endif
 
 typedef struct {
@@ -144,6 +180,38 @@ typedef struct {
     Header_t Header;
     uint32_t Timestamp;
 } CMD_052F_t;
+
+typedef struct {
+    Header_t Header;
+    uint16_t Period_10ms;   // 0 stops
+    uint8_t  Padding[2];
+} CMD_0539_t;
+#endif
+
+#ifdef ENABLE_TRACE
+typedef struct {
+    Header_t Header;
+    uint32_t Index;
+} CMD_0533_t;
+
+#ifdef ENABLE_REG_TRACE
+typedef struct {
+    Header_t Header;
+    uint8_t  Enable;
+    uint8_t  Padding[3];
+} CMD_0535_t;
+#endif
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint32_t      Head;         // events recorded since boot
+        uint32_t      Index;        // sequence number of Entries[0]
+        uint8_t       Count;
+        uint8_t       Padding[3];
+        TRACE_Entry_t Entries[16];
+    } Data;
+} REPLY_0533_t;
 #endif
 
 static const uint8_t Obfuscation[16] =
@@ -170,6 +238,13 @@ static void SendReply(void *pReply, uint16_t Size)
     Header_t Header;
     Footer_t Footer;
 
+#ifdef ENABLE_REG_TRACE
+    TRACE_StreamEndFrame();
+#endif
+#ifdef ENABLE_EXTRA_UART_CMD
+    TELEMETRY_EndFrame();
+#endif
+
     if (bIsEncrypted)
     {
         uint8_t     *pBytes = (uint8_t *)pReply;
@@ -244,6 +319,15 @@ static void CMD_0514(const uint8_t *pBuffer)
 
     Timestamp = pCmd->Timestamp;
 
+    #ifdef ENABLE_REG_TRACE
+        // a new session, the programmer does not want trace frames in its replies
+        TRACE_StreamEndFrame();
+        gTraceStreaming = false;
+    #endif
+    #ifdef ENABLE_EXTRA_UART_CMD
+        TELEMETRY_Start(0);
+    #endif
+
     #ifdef ENABLE_FMRADIO
         gFmRadioCountdown_500ms = fm_radio_countdown_500ms;
     #endif
@@ -323,6 +407,10 @@ static void CMD_051D(const uint8_t *pBuffer)
                 if (!gIsLocked)
                     bReloadEeprom = true;
 
+            // any overlap, an unaligned write can start just below the calibration
+            if (Offset + 8U > CALIBRATION_EEPROM_START && Offset < CALIBRATION_EEPROM_END)
+                SETTINGS_InvalidateCalibration();
+
             if ((Offset < 0x0E98 || Offset >= 0x0EA0) || !bIsInLockScreen || pCmd->bAllowPassword)
                 EEPROM_WriteBuffer(Offset, &pCmd->Data[i * 8U]);
         }
@@ -334,6 +422,43 @@ static void CMD_051D(const uint8_t *pBuffer)
     SendReply(&Reply, sizeof(Reply));
 }
 
+// CRC16 of each block of an EEPROM range, lets the programming software
+// read and write only the blocks that differ from its copy
+static void CMD_0537(const uint8_t *pBuffer)
+{
+    const CMD_0537_t *pCmd = (const CMD_0537_t *)pBuffer;
+    REPLY_0537_t      Reply;
+    uint8_t           Block[128];
+    uint8_t           Count = pCmd->Count;
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    if (pCmd->BlockSize == 0 || pCmd->BlockSize > sizeof(Block) || Count > ARRAY_SIZE(Reply.Data.CRC))
+        Count = 0;
+
+    if (pCmd->Offset + Count * pCmd->BlockSize > 0x2000)   // past the end of the EEPROM
+        Count = 0;
+
+    if (bHasCustomAesKey && gIsLocked)
+        Count = 0;
+
+    Reply.Header.ID      = 0x0538;
+    Reply.Header.Size    = 4 + Count * 2;
+    Reply.Data.Offset    = pCmd->Offset;
+    Reply.Data.BlockSize = pCmd->BlockSize;
+    Reply.Data.Count     = Count;
+
+    for (unsigned int i = 0; i < Count; i++) {
+        EEPROM_ReadBuffer(pCmd->Offset + i * pCmd->BlockSize, Block, pCmd->BlockSize);
+        Reply.Data.CRC[i] = CRC_Calculate(Block, pCmd->BlockSize);
+    }
+
+    SendReply(&Reply, 8 + Count * 2);
+}
+
 #ifdef ENABLE_EXTRA_UART_CMD
 // read RSSI
 static void CMD_0527(void)
@@ -363,6 +488,39 @@ static void CMD_0529(void)
     SendReply(&Reply, sizeof(Reply));
 }
 
+// read power save statistics and the battery runtime estimate
+static void CMD_0531(void)
+{
+    REPLY_0531_t Reply;
+
+    Reply.Header.ID                = 0x0532;
+    Reply.Header.Size              = sizeof(Reply.Data);
+    for (unsigned int i = 0; i < FUNCTION_N_ELEM; i++)
+        Reply.Data.FunctionTime_10ms[i] = gFunctionTime_10ms[i];
+    Reply.Data.PowerSaveAwake_10ms = gPowerSaveAwake_10ms;
+    Reply.Data.DutyCycle           = FUNCTION_PowerSaveDutyCycle();
+    Reply.Data.SleepWindow_10ms    = FUNCTION_PowerSaveSleep_10ms();
+    Reply.Data.Current_mA          = FUNCTION_EstimateCurrent_mA();
+    Reply.Data.Quiet_500ms         = gPowerSaveQuiet_500ms;
+    Reply.Data.Remaining_mAh       = BATTERY_RemainingCapacity_mAh();
+    Reply.Data.RemainingMinutes    = BATTERY_RemainingMinutes();
+
+    SendReply(&Reply, sizeof(Reply));
+}
+
+// push telemetry frames every Period_10ms until stopped, or until the next session
+static void CMD_0539(const uint8_t *pBuffer)
+{
+    const CMD_0539_t *pCmd = (const CMD_0539_t *)pBuffer;
+
+    #ifdef ENABLE_REG_TRACE
+        TRACE_StreamEndFrame();
+        gTraceStreaming = false;
+    #endif
+
+    TELEMETRY_Start(pCmd->Period_10ms);
+}
+
 #ifndef ENABLE_FEAT_F4HWN
 static void CMD_052D(const uint8_t *pBuffer)
 {
@@ -484,6 +642,53 @@ static void CMD_0602_WriteBK4819Reg(const uint8_t *pBuffer)
 }
 #endif
 
+#ifdef ENABLE_TRACE
+// read the flight recorder, up to 16 events from sequence number Index on,
+// events that have already been overwritten are skipped
+static void CMD_0533(const uint8_t *pBuffer)
+{
+    const CMD_0533_t *pCmd  = (const CMD_0533_t *)pBuffer;
+    const uint32_t    Head  = gTraceHead;
+    uint32_t          Index = pCmd->Index;
+    REPLY_0533_t      Reply;
+
+    if (Head > TRACE_LEN && Index < Head - TRACE_LEN)
+        Index = Head - TRACE_LEN;
+
+    Reply.Header.ID   = 0x0534;
+    Reply.Header.Size = sizeof(Reply.Data);
+    Reply.Data.Head   = Head;
+    Reply.Data.Index  = Index;
+    Reply.Data.Count  = 0;
+    memset(Reply.Data.Padding, 0, sizeof(Reply.Data.Padding));
+    memset(Reply.Data.Entries, 0, sizeof(Reply.Data.Entries));
+
+    while (Index < Head && Reply.Data.Count < ARRAY_SIZE(Reply.Data.Entries))
+        Reply.Data.Entries[Reply.Data.Count++] = gTrace[Index++ % TRACE_LEN];
+
+    SendReply(&Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_REG_TRACE
+// start or stop streaming the trace, BK4819 register accesses included
+static void CMD_0535(const uint8_t *pBuffer)
+{
+    const CMD_0535_t *pCmd = (const CMD_0535_t *)pBuffer;
+
+    if (pCmd->Enable) {
+        #ifdef ENABLE_EXTRA_UART_CMD
+            TELEMETRY_Start(0);   // one stream at a time, the frames would interleave
+        #endif
+        TRACE_StreamStart();
+    }
+    else {
+        TRACE_StreamEndFrame();
+        gTraceStreaming = false;
+    }
+}
+#endif
+
 bool UART_IsCommandAvailable(void)
 {
     uint16_t Index;
@@ -617,8 +822,20 @@ void UART_HandleCommand(void)
         case 0x052F:
             CMD_052F(UART_Command.Buffer);
             break;
+
+        case 0x0531:
+            CMD_0531();
+            break;
+
+        case 0x0539:
+            CMD_0539(UART_Command.Buffer);
+            break;
 #endif
     
+        case 0x0537:
+            CMD_0537(UART_Command.Buffer);
+            break;
+
         case 0x05DD: // reset
             #if defined(ENABLE_OVERLAY)
                 overlay_FLASH_RebootToBootloader();
@@ -636,6 +853,18 @@ void UART_HandleCommand(void)
             CMD_0602_WriteBK4819Reg(UART_Command.Buffer);
             break;
 #endif
+
+#ifdef ENABLE_TRACE
+        case 0x0533:
+            CMD_0533(UART_Command.Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_REG_TRACE
+        case 0x0535:
+            CMD_0535(UART_Command.Buffer);
+            break;
+#endif
     }
     #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
         gUART_LockScreenshot = 20; // lock screenshot
@@ -0,0 +1,280 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host benchmark of the firmware's pure logic hot paths
+//
+// every benchmark is run a few times, the best and the median ns per call
+// are reported as JSON (stdout, or the file named on the command line)
+// so a change in the numbers shows up in review
+
+#define _POSIX_C_SOURCE 199309L   // clock_gettime()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "am_fix.h"
+#include "app/cw.h"
+#include "bench/stubs.h"
+#include "dcs.h"
+#include "driver/st7565.h"
+#include "frequencies.h"
+#include "misc.h"
+#include "screenshot.h"
+#include "settings.h"
+#include "ui/helper.h"
+
+#ifndef BENCH_ITERATIONS
+    #define BENCH_ITERATIONS 0
+#endif
+
+#define BENCH_RUNS 7
+
+typedef struct {
+    const char *name;
+    double    (*run)(uint32_t iterations);  // returns the per call metric, if any
+    uint32_t    iterations;                 // calls per run
+    const char *metric;                     // name of what run() returns, NULL for none
+} bench_t;
+
+static volatile uint32_t sink;   // keeps the compiler from dropping the work
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+
+static uint32_t dcs_words[ARRAY_SIZE(DCS_Options) * 2];
+
+static double bench_dcs_get_cdcss_code(uint32_t iterations)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        const uint32_t word = dcs_words[i % ARRAY_SIZE(dcs_words)];
+        // the receiver hands the code over at an arbitrary rotation
+        const unsigned rot  = i % 23;
+        const uint32_t code = ((word >> rot) | (word << (23 - rot))) & 0x7FFFFFu;
+        acc += DCS_GetCdcssCode(code);
+    }
+    sink = acc;
+    return 0;
+}
+
+static double bench_frequency_round_to_step(uint32_t iterations)
+{
+    uint32_t acc  = 0;
+    uint32_t freq = 14400000;
+    for (uint32_t i = 0; i < iterations; i++) {
+        acc  += FREQUENCY_RoundToStep(freq, gStepFrequencyTable[i % STEP_N_ELEM]);
+        freq += 1237;
+        if (freq > 44000000)
+            freq = 14400000;
+    }
+    sink = acc;
+    return 0;
+}
+
+static double bench_freq_check(uint32_t iterations, int32_t (*check)(uint32_t))
+{
+    const uint32_t span = BX4819_band2.upper - BX4819_band1.lower;
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        gSetting_F_LOCK = i % F_LOCK_LEN;
+        acc += check(BX4819_band1.lower + (i * 7919u) % span);
+    }
+    gSetting_F_LOCK = F_LOCK_DEF;
+    sink = acc;
+    return 0;
+}
+
+static double bench_tx_freq_check(uint32_t iterations)
+{
+    return bench_freq_check(iterations, TX_freq_check);
+}
+
+static double bench_rx_freq_check(uint32_t iterations)
+{
+    return bench_freq_check(iterations, RX_freq_check);
+}
+
+static double bench_ui_print_string(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        UI_PrintString("MEMORY 123", 0, 127, i % 6, 8);
+    sink = gFrameBuffer[0][10];
+    return 0;
+}
+
+static double bench_ui_print_string_small(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        UI_PrintStringSmallNormal("VFO A 145.50000", 0, 0, i % 7);
+        UI_PrintStringSmallBold("FM NFM 12.5k", 0, 0, (i + 3) % 7);
+    }
+    sink = gFrameBuffer[0][10];
+    return 0;
+}
+
+static double bench_ui_display_frequency(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        UI_DisplayFrequency(" 145.500", 32, (i & 1) ? 1 : 4, false);
+    sink = gFrameBuffer[1][40];
+    return 0;
+}
+
+static double bench_ui_display_frequency_big(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        UI_DisplayFrequencyBig(14550000 + (i % 64) * 1250, 32, (i & 1) ? 1 : 4);
+    sink = gFrameBuffer[1][40];
+    return 0;
+}
+
+static double bench_screenshot_delta(uint32_t iterations)
+{
+    gBenchUartBytes = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        // a typical idle main screen: the rssi bar and a few digits change
+        gFrameBuffer[5][(i * 13) % LCD_WIDTH] ^= 0x3C;
+        gStatusLine[(i * 7) % LCD_WIDTH]      ^= 0x01;
+        getScreenShot(false);
+    }
+    return (double)gBenchUartBytes / iterations;
+}
+
+static double bench_screenshot_full(uint32_t iterations)
+{
+    gBenchUartBytes = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        getScreenShot(true);
+    return (double)gBenchUartBytes / iterations;
+}
+
+static double bench_am_fix_10ms(uint32_t iterations)
+{
+    gBenchRegWrites = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        // sweep a carrier in and out of the target window every second
+        gBenchRssi = 80 + (int16_t)((i % 100) < 50 ? (i % 50) * 4 : (50 - i % 50) * 4);
+        AM_fix_10ms(0, MODULATION_AM);
+    }
+    sink = AM_fix_get_gain_diff();
+    return (double)gBenchRegWrites / iterations;
+}
+
+static const char cw_message[] = "CQ CQ DE N0CALL N0CALL K";
+
+static double bench_cw_transmit_string(uint32_t iterations)
+{
+    gBenchDelay_ms = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        CW_Transmit_String(cw_message, 20);
+    return (double)gBenchDelay_ms / iterations;
+}
+
+// ---------------------------------------------------------------------------
+
+static bench_t benches[] = {
+    {"dcs_get_cdcss_code",          bench_dcs_get_cdcss_code,       200000, NULL},
+    {"frequency_round_to_step",     bench_frequency_round_to_step, 5000000, NULL},
+    {"tx_freq_check",               bench_tx_freq_check,           5000000, NULL},
+    {"rx_freq_check",               bench_rx_freq_check,           5000000, NULL},
+    {"ui_print_string",             bench_ui_print_string,         1000000, NULL},
+    {"ui_print_string_small",       bench_ui_print_string_small,   1000000, NULL},
+    {"ui_display_frequency",        bench_ui_display_frequency,    1000000, NULL},
+    {"ui_display_frequency_big",    bench_ui_display_frequency_big, 1000000, NULL},
+    {"screenshot_delta",            bench_screenshot_delta,          20000, "uart_bytes_per_call"},
+    {"screenshot_full",             bench_screenshot_full,           20000, "uart_bytes_per_call"},
+    {"am_fix_10ms",                 bench_am_fix_10ms,             2000000, "reg_writes_per_call"},
+    {"cw_transmit_string",          bench_cw_transmit_string,        50000, "on_air_ms_per_call"},
+};
+
+static void setup(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(DCS_Options); i++) {
+        dcs_words[i * 2 + 0] = DCS_GetGolayCodeWord(CODE_TYPE_DIGITAL, i);
+        dcs_words[i * 2 + 1] = DCS_GetGolayCodeWord(CODE_TYPE_REVERSE_DIGITAL, i);
+    }
+
+    static FREQ_Config_t rx = {.Frequency = 2700000};
+    gEeprom.VfoInfo[0].pRX  = &rx;
+    gSetting_AM_fix         = true;
+    AM_fix_init();
+
+    gCWSettings.enabled = true;
+    gCWSettings.tone_hz = 600;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *out = stdout;
+
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == NULL) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    setup();
+
+    fprintf(out, "{\n  \"suite\": \"uv-k5 host bench\",\n  \"compiler\": \"%s\",\n  \"runs\": %u,\n  \"results\": [\n",
+        __VERSION__, BENCH_RUNS);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(benches); i++) {
+        bench_t *b = &benches[i];
+        double   ns[BENCH_RUNS];
+        double   metric = 0;
+
+        if (BENCH_ITERATIONS > 0)
+            b->iterations = BENCH_ITERATIONS;
+
+        for (unsigned r = 0; r < BENCH_RUNS; r++) {
+            const uint64_t start = now_ns();
+            metric = b->run(b->iterations);
+            ns[r]  = (double)(now_ns() - start) / b->iterations;
+        }
+
+        qsort(ns, BENCH_RUNS, sizeof(ns[0]), compare_double);
+
+        fprintf(out, "    {\"name\": \"%s\", \"iterations\": %u, \"best_ns\": %.2f, \"median_ns\": %.2f",
+            b->name, b->iterations, ns[0], ns[BENCH_RUNS / 2]);
+        if (b->metric != NULL)
+            fprintf(out, ", \"%s\": %.2f", b->metric, metric);
+        fprintf(out, "}%s\n", (i + 1 < ARRAY_SIZE(benches)) ? "," : "");
+    }
+
+    fprintf(out, "  ]\n}\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
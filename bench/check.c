@@ -0,0 +1,300 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host checks of the firmware's table driven code
+//
+// every check prints its failures and a summary line, the exit status is
+// the number of checks that failed so "make -C bench check" stops on one
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app/menu.h"
+#include "driver/eeprom.h"
+#include "frequencies.h"
+#include "misc.h"
+#include "settings.h"
+#include "ui/menu.h"
+
+typedef struct {
+    const char *name;
+    unsigned  (*run)(void);   // returns the number of failures
+} check_t;
+
+static uint8_t eeprom[0x2000];
+
+void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
+{
+    memcpy(pBuffer, &eeprom[Address % sizeof(eeprom)], Size);
+}
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+    if (pBuffer != NULL && Address <= sizeof(eeprom) - 8)
+        memcpy(&eeprom[Address], pBuffer, 8);
+}
+
+// ---------------------------------------------------------------------------
+
+#ifndef CHECK_TX_RANGES_ONLY
+static int32_t setting_get(const menu_setting_t *s)
+{
+    return (s->flags & MENU_F_U16) ? *(const uint16_t *)s->storage : *(const uint8_t *)s->storage;
+}
+
+static void setting_set(const menu_setting_t *s, const int32_t value)
+{
+    if (s->flags & MENU_F_U16)
+        *(uint16_t *)s->storage = value;
+    else
+        *(uint8_t *)s->storage = value;
+}
+
+// every value of every global menu setting survives a save of the block the
+// table names for it and a reload from eeprom, and leaves the others alone
+static unsigned check_menu_settings_round_trip(void)
+{
+    static int32_t before[MENU_BATTYP + 1];
+    unsigned       failures = 0;
+
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    SETTINGS_InitEEPROM();
+    SETTINGS_SaveSettings();
+
+    for (uint8_t id = 0; id <= MENU_BATTYP; id++) {
+        const menu_setting_t *s = MENU_GetSetting(id);
+
+        if (s->storage == NULL || s->block == SETTINGS_BLOCK_NONE)
+            continue;
+
+        for (int32_t value = s->min; value <= s->max; value++) {
+            for (uint8_t i = 0; i <= MENU_BATTYP; i++) {
+                const menu_setting_t *o = MENU_GetSetting(i);
+                if (o->storage != NULL)
+                    before[i] = setting_get(o);
+            }
+
+            setting_set(s, value);
+            SETTINGS_SaveSettingsBlocks(SETTINGS_BLOCK_BIT(s->block));
+            setting_set(s, value == s->min ? s->max : s->min);
+            SETTINGS_InitEEPROM();
+
+            if (setting_get(s) != value) {
+                printf("  menu %u: wrote %d, read back %d\n", id, value, setting_get(s));
+                failures++;
+            }
+
+            for (uint8_t i = 0; i <= MENU_BATTYP; i++) {
+                const menu_setting_t *o = MENU_GetSetting(i);
+                if (i != id && o->storage != NULL && o->storage != s->storage && setting_get(o) != before[i]) {
+                    printf("  menu %u = %d changed menu %u from %d to %d\n", id, value, i, before[i], setting_get(o));
+                    failures++;
+                }
+            }
+
+            // put the original back for the next setting
+            setting_set(s, before[id]);
+            SETTINGS_SaveSettingsBlocks(SETTINGS_BLOCK_BIT(s->block));
+        }
+    }
+
+    return failures;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+
+// TX_freq_check() as it was before the per lock mode range tables, kept
+// as the reference the tables have to agree with, the band edges come from
+// frequencyBandTable[] so a range table can't agree with a wrong copy of them
+static int32_t tx_freq_check_reference(const uint32_t Frequency)
+{   // return '0' if TX frequency is allowed
+    // otherwise return '-1'
+
+    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
+        return 1;  // not allowed outside this range
+
+    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
+        return -1;  // BX chip does not work in this range
+
+    switch (gSetting_F_LOCK)
+    {
+        case F_LOCK_DEF:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND4_174MHz].lower && Frequency < frequencyBandTable[BAND4_174MHz].upper)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_200TX)
+            #endif
+                    return 0;
+            if (Frequency >= frequencyBandTable[BAND5_350MHz].lower && Frequency < frequencyBandTable[BAND5_350MHz].upper)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_350TX && gSetting_350EN)
+            #else
+                if (gSetting_350EN)                
+            #endif
+                    return 0;
+            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < frequencyBandTable[BAND6_400MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND7_470MHz].lower && Frequency <= 60000000)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_500TX)
+            #endif
+                    return 0;
+            break;
+
+        case F_LOCK_FCC:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 42000000 && Frequency < 45000000)
+                return 0;
+            break;
+
+        case F_LOCK_CE:
+            if (Frequency >= 14400000 && Frequency < 14600000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 44000000)
+                return 0;
+            break;
+
+        case F_LOCK_GB:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 44000000)
+                return 0;
+            break;
+
+        case F_LOCK_430:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < 43000000)
+                return 0;
+            break;
+
+        case F_LOCK_438:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < 43800000)
+                return 0;
+            break;
+
+#ifdef ENABLE_FEAT_F4HWN_PMR
+        case F_LOCK_PMR:
+            if (Frequency >= 44600625 && Frequency <= 44619375)
+                return 0;
+            break;
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
+        case F_LOCK_GMRS_FRS_MURS:
+            // https://forums.radioreference.com/threads/the-great-unofficial-radioreference-frs-gmrs-murs-fact-sheet.275370/
+            if ((Frequency >= 46255000 && Frequency <= 46272500) ||
+                (Frequency >= 46755000 && Frequency <= 46772500)) // FRS/GMRS
+                return 0;
+            if (Frequency == 15182000 || 
+                Frequency == 15188000 || 
+                Frequency == 15194000 || 
+                Frequency == 15457000 || 
+                Frequency == 15460000) // MURS
+                return 0;
+            break;
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_CA 
+        case F_LOCK_CA:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 45000000)
+                return 0;
+            break;
+#endif
+
+        case F_LOCK_ALL:
+            break;
+
+        case F_LOCK_NONE:
+            for (uint32_t i = 0; i < BAND_N_ELEM; i++)
+                if (Frequency >= frequencyBandTable[i].lower && Frequency < frequencyBandTable[i].upper)
+                    return 0;
+            break;
+    }
+
+    // dis-allowed TX frequency
+    return -1;
+}
+
+// every 10 Hz step from 18 to 1300 MHz, in every lock mode and with and
+// without the settings the default lock mode depends on
+static unsigned check_tx_freq_ranges(void)
+{
+    unsigned failures = 0;
+
+    for (uint8_t lock = 0; lock < F_LOCK_LEN; lock++) {
+        for (uint8_t settings = 0; settings < 16; settings++) {
+            if (settings != 0 && lock != F_LOCK_DEF)
+                break;   // only the default lock mode reads them
+
+            gSetting_F_LOCK = lock;
+            gSetting_350EN  = settings & 1;
+#ifndef ENABLE_FEAT_F4HWN
+            gSetting_200TX  = settings & 2;
+            gSetting_350TX  = settings & 4;
+            gSetting_500TX  = settings & 8;
+#else
+            if (settings > 1)
+                break;
+#endif
+
+            for (uint32_t Frequency = 1800000; Frequency <= 130000000; Frequency++) {
+                const int32_t expected = tx_freq_check_reference(Frequency);
+                const int32_t result   = TX_freq_check(Frequency);
+
+                if (result != expected) {
+                    if (failures < 10)
+                        printf("  lock %u settings %x %u: %d, expected %d\n", lock, settings, Frequency, result, expected);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+
+static const check_t checks[] = {
+#ifndef CHECK_TX_RANGES_ONLY
+    {"menu_settings_round_trip", check_menu_settings_round_trip},
+#endif
+    {"tx_freq_ranges",           check_tx_freq_ranges},
+};
+
+int main(void)
+{
+    unsigned failed = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(checks); i++) {
+        const unsigned failures = checks[i].run();
+        printf("%s: %s", checks[i].name, failures ? "FAIL" : "ok");
+        if (failures)
+            printf(" (%u)", failures);
+        printf("\n");
+        failed += failures != 0;
+    }
+
+    return failed;
+}
@@ -0,0 +1,126 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host replacements for the hardware the benchmarked sources call into
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench/stubs.h"
+#include "driver/bk4819.h"
+#include "driver/eeprom.h"
+#include "driver/st7565.h"
+#include "driver/system.h"
+#include "driver/uart.h"
+#include "functions.h"
+#include "settings.h"
+
+uint8_t          gStatusLine[LCD_WIDTH];
+uint8_t          gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+
+EEPROM_Config_t  gEeprom;
+FUNCTION_Type_t  gCurrentFunction = FUNCTION_RECEIVE;
+
+uint32_t         gBenchUartBytes;
+uint32_t         gBenchDelay_ms;
+uint32_t         gBenchRegWrites;
+int16_t          gBenchRssi = 200;
+
+// display
+
+void ST7565_BlitFullScreen(void) {}
+void ST7565_BlitStatusLine(void) {}
+void ST7565_BlitLine(unsigned line) { (void)line; }
+void ST7565_BlitLineRange(unsigned line, unsigned column, unsigned width) { (void)line; (void)column; (void)width; }
+void ST7565_FillScreen(uint8_t value) { memset(gFrameBuffer, value, sizeof(gFrameBuffer)); }
+
+// uart
+
+void UART_Send(const void *pBuffer, uint32_t Size)
+{
+    (void)pBuffer;
+    gBenchUartBytes += Size;
+}
+
+bool UART_IsCableConnected(void)
+{
+    return true;
+}
+
+// radio
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    (void)Register;
+    (void)Data;
+    gBenchRegWrites++;
+}
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    (void)Register;
+    return 0;
+}
+
+uint16_t BK4819_GetRSSI(void)
+{
+    return gBenchRssi;
+}
+
+void BK4819_EnterTxMute(void) { gBenchRegWrites++; }
+void BK4819_ExitTxMute(void)  { gBenchRegWrites++; }
+void BK4819_EnableTXLink(void) { gBenchRegWrites++; }
+void BK4819_SetAF(BK4819_AF_Type_t AF) { (void)AF; gBenchRegWrites++; }
+
+// system
+
+void SYSTEM_DelayMs(uint32_t Delay)
+{
+    gBenchDelay_ms += Delay;
+}
+
+void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
+{
+    (void)Address;
+    memset(pBuffer, 0xFF, Size);
+}
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+    (void)Address;
+    (void)pBuffer;
+}
+
+// application
+
+bool FUNCTION_IsRx(void)
+{
+    return gCurrentFunction == FUNCTION_RECEIVE || gCurrentFunction == FUNCTION_MONITOR || gCurrentFunction == FUNCTION_INCOMING;
+}
+
+void FUNCTION_Select(FUNCTION_Type_t Function)
+{
+    gCurrentFunction = Function;
+}
+
+void RADIO_PrepareTX(void) {}
+void APP_EndTransmission(void) {}
+
+// printf back end, nothing on the bench prints through it
+void _putchar(char c)
+{
+    (void)c;
+}
@@ -0,0 +1,30 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef BENCH_STUBS_H
+#define BENCH_STUBS_H
+
+#include <stdint.h>
+
+// counters the hardware stubs accumulate, so each benchmark can report
+// what the code would have done on the radio besides how long it took
+
+extern uint32_t gBenchUartBytes;
+extern uint32_t gBenchDelay_ms;
+extern uint32_t gBenchRegWrites;
+extern int16_t  gBenchRssi;
+
+#endif
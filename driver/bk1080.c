@@ -46,23 +46,12 @@ void BK1080_Init0(void)
 
 void BK1080_Init(uint16_t freq, uint8_t band/*, uint8_t space*/)
 {
-    unsigned int i;
-
     if (freq) {
         GPIO_ClearBit(&GPIOB->DATA, GPIOB_PIN_BK1080);
 
         if (!gIsInitBK1080) {
-            for (i = 0; i < ARRAY_SIZE(BK1080_RegisterTable); i++)
-                BK1080_WriteRegister(i, BK1080_RegisterTable[i]);
-
-            SYSTEM_DelayMs(250);
-
-            BK1080_WriteRegister(BK1080_REG_25_INTERNAL, 0xA83C);
-            BK1080_WriteRegister(BK1080_REG_25_INTERNAL, 0xA8BC);
-
-            SYSTEM_DelayMs(60);
-
-            gIsInitBK1080 = true;
+            for (uint8_t step = 0, wait; (wait = BK1080_PowerUpStep(step)) > 0; step++)
+                SYSTEM_DelayMs(wait * 10);
         }
         else {
             BK1080_WriteRegister(BK1080_REG_02_POWER_CONFIGURATION, 0x0201);
@@ -81,6 +70,35 @@ void BK1080_Init(uint16_t freq, uint8_t band/*, uint8_t space*/)
     }
 }
 
+uint8_t BK1080_PowerUpStep(uint8_t step)
+{
+    switch (step) {
+        case 0:
+            GPIO_ClearBit(&GPIOB->DATA, GPIOB_PIN_BK1080);
+
+            if (gIsInitBK1080) {
+                // BK1080_Init0 powered it down, wake it like BK1080_Init does
+                BK1080_WriteRegister(BK1080_REG_02_POWER_CONFIGURATION, 0x0201);
+                return 0;
+            }
+
+            for (unsigned int i = 0; i < ARRAY_SIZE(BK1080_RegisterTable); i++)
+                BK1080_WriteRegister(i, BK1080_RegisterTable[i]);
+
+            return 250 / 10;
+
+        case 1:
+            BK1080_WriteRegister(BK1080_REG_25_INTERNAL, 0xA83C);
+            BK1080_WriteRegister(BK1080_REG_25_INTERNAL, 0xA8BC);
+
+            return 60 / 10;
+
+        default:
+            gIsInitBK1080 = true;
+            return 0;
+    }
+}
+
 uint16_t BK1080_ReadRegister(BK1080_Register_t Register)
 {
     uint8_t Value[2];
@@ -114,6 +132,13 @@ void BK1080_SetFrequency(uint16_t frequency, uint8_t band/*, uint8_t space*/)
     //uint8_t spacings[] = {20,10,5};
     //space %= 3;
 
+    const uint16_t channel = BK1080_SelectFrequency(frequency, band/*, space*/);
+    SYSTEM_DelayMs(10);
+    BK1080_TuneChannel(channel);
+}
+
+uint16_t BK1080_SelectFrequency(uint16_t frequency, uint8_t band/*, uint8_t space*/)
+{
     uint16_t channel = (frequency - BK1080_GetFreqLoLimit(band))/* * 10 / spacings[space]*/;
 
     uint16_t regval = BK1080_ReadRegister(BK1080_REG_05_SYSTEM_CONFIGURATION2);
@@ -123,7 +148,12 @@ void BK1080_SetFrequency(uint16_t frequency, uint8_t band/*, uint8_t space*/)
     BK1080_WriteRegister(BK1080_REG_05_SYSTEM_CONFIGURATION2, regval);
 
     BK1080_WriteRegister(BK1080_REG_03_CHANNEL, channel);
-    SYSTEM_DelayMs(10);
+
+    return channel;
+}
+
+void BK1080_TuneChannel(uint16_t channel)
+{
     BK1080_WriteRegister(BK1080_REG_03_CHANNEL, channel | 0x8000);
 }
 
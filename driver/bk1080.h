@@ -26,12 +26,18 @@ extern uint16_t BK1080_FrequencyDeviation;
 
 void BK1080_Init0(void);
 void BK1080_Init(uint16_t Frequency, uint8_t band/*, uint8_t space*/);
+// one power-up stage per call, returns the 10ms slices to wait before the next
+// stage or 0 once the chip is ready; lets callers power up without blocking
+uint8_t BK1080_PowerUpStep(uint8_t step);
 uint16_t BK1080_ReadRegister(BK1080_Register_t Register);
 void BK1080_WriteRegister(BK1080_Register_t Register, uint16_t Value);
 void BK1080_Mute(bool Mute);
 uint16_t BK1080_GetFreqLoLimit(uint8_t band);
 uint16_t BK1080_GetFreqHiLimit(uint8_t band);
 void BK1080_SetFrequency(uint16_t frequency, uint8_t band/*, uint8_t space*/);
+// BK1080_SetFrequency() split in two, the tune bit needs 10ms between them
+uint16_t BK1080_SelectFrequency(uint16_t frequency, uint8_t band/*, uint8_t space*/);
+void BK1080_TuneChannel(uint16_t channel);
 void BK1080_GetFrequencyDeviation(uint16_t Frequency);
 
 #endif
@@ -0,0 +1,149 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// the bit-banged 3-wire bus to the BK4819, kept apart from the rest of the
+// driver so the host replay (see replay/) can put a register model in its place
+
+#include <stdint.h>
+
+#include "../bsp/dp32g030/gpio.h"
+#include "../bsp/dp32g030/portcon.h"
+#include "../sram-text.h"
+#include "../trace.h"
+
+#include "bk4819.h"
+#include "gpio.h"
+#include "systick.h"
+
+SRAM_TEXT static uint16_t BK4819_ReadU16(void)
+{
+    unsigned int i;
+    uint16_t     Value;
+
+    PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_ENABLE;
+    GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_INPUT;
+    SYSTICK_DelayUs(1);
+    Value = 0;
+    for (i = 0; i < 16; i++)
+    {
+        Value <<= 1;
+        Value |= GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+        SYSTICK_DelayUs(1);
+        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+        SYSTICK_DelayUs(1);
+    }
+    PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_DISABLE;
+    GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_OUTPUT;
+
+    return Value;
+}
+
+SRAM_TEXT uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    uint16_t Value;
+
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+
+    SYSTICK_DelayUs(1);
+
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+    BK4819_WriteU8(Register | 0x80);
+    Value = BK4819_ReadU16();
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+
+    SYSTICK_DelayUs(1);
+
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+
+    TRACE_BK4819(TRACE_BK4819_READ, Register, Value);
+
+    return Value;
+}
+
+SRAM_TEXT void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    TRACE_BK4819(TRACE_BK4819_WRITE, Register, Data);
+
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+
+    SYSTICK_DelayUs(1);
+
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+    BK4819_WriteU8(Register);
+
+    SYSTICK_DelayUs(1);
+
+    BK4819_WriteU16(Data);
+
+    SYSTICK_DelayUs(1);
+
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+
+    SYSTICK_DelayUs(1);
+
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+}
+
+SRAM_TEXT void BK4819_WriteU8(uint8_t Data)
+{
+    unsigned int i;
+
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+    for (i = 0; i < 8; i++)
+    {
+        if ((Data & 0x80) == 0)
+            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+        else
+            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+
+        SYSTICK_DelayUs(1);
+        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+        SYSTICK_DelayUs(1);
+
+        Data <<= 1;
+
+        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+        SYSTICK_DelayUs(1);
+    }
+}
+
+SRAM_TEXT void BK4819_WriteU16(uint16_t Data)
+{
+    unsigned int i;
+
+    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+    for (i = 0; i < 16; i++)
+    {
+        if ((Data & 0x8000) == 0)
+            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+        else
+            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+
+        SYSTICK_DelayUs(1);
+        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+
+        Data <<= 1;
+
+        SYSTICK_DelayUs(1);
+        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+        SYSTICK_DelayUs(1);
+    }
+}
@@ -21,7 +21,7 @@
 
 #include "../audio.h"
 #include "../bsp/dp32g030/gpio.h"
-#include "../bsp/dp32g030/portcon.h"
+#include "../sram-text.h"
 
 #include "bk4819.h"
 #include "gpio.h"
@@ -124,122 +124,6 @@ void BK4819_Init(void)
     BK4819_WriteRegister(BK4819_REG_3F, 0);
 }
 
-static uint16_t BK4819_ReadU16(void)
-{
-    unsigned int i;
-    uint16_t     Value;
-
-    PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_ENABLE;
-    GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_INPUT;
-    SYSTICK_DelayUs(1);
-    Value = 0;
-    for (i = 0; i < 16; i++)
-    {
-        Value <<= 1;
-        Value |= GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        SYSTICK_DelayUs(1);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        SYSTICK_DelayUs(1);
-    }
-    PORTCON_PORTC_IE = (PORTCON_PORTC_IE & ~PORTCON_PORTC_IE_C2_MASK) | PORTCON_PORTC_IE_C2_BITS_DISABLE;
-    GPIOC->DIR = (GPIOC->DIR & ~GPIO_DIR_2_MASK) | GPIO_DIR_2_BITS_OUTPUT;
-
-    return Value;
-}
-
-uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
-{
-    uint16_t Value;
-
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-
-    SYSTICK_DelayUs(1);
-
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-    BK4819_WriteU8(Register | 0x80);
-    Value = BK4819_ReadU16();
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-
-    SYSTICK_DelayUs(1);
-
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-
-    return Value;
-}
-
-void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
-{
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-
-    SYSTICK_DelayUs(1);
-
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-    BK4819_WriteU8(Register);
-
-    SYSTICK_DelayUs(1);
-
-    BK4819_WriteU16(Data);
-
-    SYSTICK_DelayUs(1);
-
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-
-    SYSTICK_DelayUs(1);
-
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-    GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-}
-
-void BK4819_WriteU8(uint8_t Data)
-{
-    unsigned int i;
-
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-    for (i = 0; i < 8; i++)
-    {
-        if ((Data & 0x80) == 0)
-            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-        else
-            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-
-        SYSTICK_DelayUs(1);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        SYSTICK_DelayUs(1);
-
-        Data <<= 1;
-
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        SYSTICK_DelayUs(1);
-    }
-}
-
-void BK4819_WriteU16(uint16_t Data)
-{
-    unsigned int i;
-
-    GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-    for (i = 0; i < 16; i++)
-    {
-        if ((Data & 0x8000) == 0)
-            GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-        else
-            GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-
-        SYSTICK_DelayUs(1);
-        GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-
-        Data <<= 1;
-
-        SYSTICK_DelayUs(1);
-        GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-        SYSTICK_DelayUs(1);
-    }
-}
-
 void BK4819_SetAGC(bool enable)
 {
     uint16_t regVal = BK4819_ReadRegister(BK4819_REG_7E);
@@ -839,6 +723,26 @@ void BK4819_PickRXFilterPathBasedOnFrequency(uint32_t Frequency)
     }
 }
 
+// Retune the receiver without touching the rest of the RX setup, the LNA path
+// is only switched when asked to (the frequency crossed the VHF/UHF edge).
+// The VCO calibration is restarted and the glitch indicator (255 while the
+// receiver is still settling) is polled so the caller's dwell starts with the
+// PLL locked, gives up after ~3ms
+void BK4819_RetuneRX(uint32_t Frequency, bool bFilterPath)
+{
+    BK4819_SetFrequency(Frequency);
+
+    if (bFilterPath)
+        BK4819_PickRXFilterPathBasedOnFrequency(Frequency);
+
+    const uint16_t Reg = BK4819_ReadRegister(BK4819_REG_30);
+    BK4819_WriteRegister(BK4819_REG_30, 0);
+    BK4819_WriteRegister(BK4819_REG_30, Reg);
+
+    for (unsigned int i = 0; i < 30 && (BK4819_ReadRegister(BK4819_REG_63) & 0xFF) >= 255; i++)
+        SYSTICK_DelayUs(100);
+}
+
 void BK4819_DisableScramble(void)
 {
     const uint16_t Value = BK4819_ReadRegister(BK4819_REG_31);
@@ -1053,14 +957,14 @@ void BK4819_TurnsOffTones_TurnsOnRX(void)
 }
 
 #ifdef ENABLE_AIRCOPY
-    void BK4819_SetupAircopy(void)
+    void BK4819_SetupAircopy(uint8_t Length)
     {
         BK4819_WriteRegister(BK4819_REG_70, 0x00E0);    // Enable Tone2, tuning gain 48
         BK4819_WriteRegister(BK4819_REG_72, 0x3065);    // Tone2 baudrate 1200
         BK4819_WriteRegister(BK4819_REG_58, 0x00C1);    // FSK Enable, FSK 1.2K RX Bandwidth, Preamble 0xAA or 0x55, RX Gain 0, RX Mode
                                                         // (FSK1.2K, FSK2.4K Rx and NOAA SAME Rx), TX Mode FSK 1.2K and FSK 2.4K Tx
         BK4819_WriteRegister(BK4819_REG_5C, 0x5665);    // Enable CRC among other things we don't know yet
-        BK4819_WriteRegister(BK4819_REG_5D, 0x4700);    // FSK Data Length 72 Bytes (0xabcd + 2 byte length + 64 byte payload + 2 byte CRC + 0xdcba)
+        BK4819_WriteRegister(BK4819_REG_5D, (Length - 1) << 8);    // FSK Data Length in bytes, 72 for the original frame (0xabcd + 2 byte offset + 64 byte payload + 2 byte CRC + 0xdcba)
     }
 #endif
 
@@ -1444,7 +1348,7 @@ void BK4819_PlayCTCSSTail(void)
     BK4819_WriteRegister(BK4819_REG_51, 0x904A); // 1 0 0 1 0 0 0 0  0  1001010
 }
 
-uint16_t BK4819_GetRSSI(void)
+SRAM_TEXT uint16_t BK4819_GetRSSI(void)
 {
     return BK4819_ReadRegister(BK4819_REG_67) & 0x01FF;
 }
@@ -1633,7 +1537,47 @@ uint8_t BK4819_GetCTCType(void)
     return (BK4819_ReadRegister(BK4819_REG_0C) >> 10) & 3u;
 }
 
-void BK4819_SendFSKData(uint16_t *pData)
+// Interrupt events, the REG_02 status words in the order the chip raised them.
+// Single producer (BK4819_IRQ_Poll) / single consumer (BK4819_IRQ_Pop), each
+// index is only written by its own side so neither needs to mask interrupts.
+#define IRQ_QUEUE_LEN 4u   // power of two
+
+static uint16_t         gIrqQueue[IRQ_QUEUE_LEN];
+static volatile uint8_t gIrqHead;
+static volatile uint8_t gIrqTail;
+
+bool BK4819_IRQ_Poll(void)
+{
+    const uint8_t Head = gIrqHead;
+
+    if ((uint8_t)(Head - gIrqTail) >= IRQ_QUEUE_LEN)
+        return false;   // full, the consumer has to catch up first
+
+    if ((BK4819_ReadRegister(BK4819_REG_0C) & 1u) == 0)
+        return false;   // no interrupt request
+
+    BK4819_WriteRegister(BK4819_REG_02, 0);   // clear the request
+    gIrqQueue[Head % IRQ_QUEUE_LEN] = BK4819_ReadRegister(BK4819_REG_02);
+    gIrqHead = Head + 1;
+
+    return true;
+}
+
+bool BK4819_IRQ_Pop(uint16_t *pStatus)
+{
+    const uint8_t Tail = gIrqTail;
+
+    if (Tail == gIrqHead)
+        return false;
+
+    *pStatus = gIrqQueue[Tail % IRQ_QUEUE_LEN];
+    gIrqTail = Tail + 1;
+
+    return true;
+}
+
+// the frame is written to the TX FIFO in one go, 64 words at most
+void BK4819_SendFSKData(const uint16_t *pData, uint8_t Words)
 {
     unsigned int i;
     uint8_t Timeout = 200;
@@ -1644,7 +1588,7 @@ void BK4819_SendFSKData(uint16_t *pData)
     BK4819_WriteRegister(BK4819_REG_59, 0x8068);
     BK4819_WriteRegister(BK4819_REG_59, 0x0068);
 
-    for (i = 0; i < 36; i++)
+    for (i = 0; i < Words; i++)
         BK4819_WriteRegister(BK4819_REG_5F, pData[i]);
 
     SYSTEM_DelayMs(20);
@@ -95,6 +95,7 @@ void     BK4819_SetupSquelch(
 void     BK4819_SetAF(BK4819_AF_Type_t AF);
 void     BK4819_RX_TurnOn(void);
 void     BK4819_PickRXFilterPathBasedOnFrequency(uint32_t Frequency);
+void     BK4819_RetuneRX(uint32_t Frequency, bool bFilterPath);
 void     BK4819_DisableScramble(void);
 void     BK4819_EnableScramble(uint8_t Type);
 
@@ -111,7 +112,7 @@ void     BK4819_ExitTxMute(void);
 void     BK4819_Sleep(void);
 void     BK4819_TurnsOffTones_TurnsOnRX(void);
 #ifdef ENABLE_AIRCOPY
-    void     BK4819_SetupAircopy(void);
+    void     BK4819_SetupAircopy(uint8_t Length);
 #endif
 void     BK4819_ResetFSK(void);
 void     BK4819_Idle(void);
@@ -159,7 +160,13 @@ uint8_t  BK4819_GetCDCSSCodeType(void);
 uint8_t  BK4819_GetCTCShift(void);
 uint8_t  BK4819_GetCTCType(void);
 
-void     BK4819_SendFSKData(uint16_t *pData);
+// The BK4819 has no interrupt line to the MCU on this board (only SCN/SCL/SDA),
+// BK4819_IRQ_Poll() stands in for the IRQ handler: it reads the interrupt
+// request flag in REG_0C and queues one REG_02 status word when it is set
+bool     BK4819_IRQ_Poll(void);
+bool     BK4819_IRQ_Pop(uint16_t *pStatus);
+
+void     BK4819_SendFSKData(const uint16_t *pData, uint8_t Words);
 void     BK4819_PrepareFSKReceive(void);
 
 void     BK4819_PlayRoger(void);
@@ -20,6 +20,7 @@
 #include "driver/eeprom.h"
 #include "driver/i2c.h"
 #include "driver/system.h"
+#include "trace.h"
 
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 {
@@ -51,6 +52,8 @@ void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
         return;
     }
 
+    TRACE(TRACE_EEPROM_WRITE, Address);
+
     I2C_Start();
     I2C_Write(0xA0);
     I2C_Write((Address >> 8) & 0xFF);
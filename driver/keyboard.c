@@ -22,10 +22,20 @@
 #include "driver/i2c.h"
 #include "misc.h"
 
-KEY_Code_t gKeyReading0     = KEY_INVALID;
-KEY_Code_t gKeyReading1     = KEY_INVALID;
-uint16_t   gDebounceCounter = 0;
-bool       gWasFKeyPressed  = false;
+KEYBOARD_State_t gKeyboard = { .Reading0 = KEY_INVALID, .Reading1 = KEY_INVALID };
+bool             gWasFKeyPressed  = false;
+
+#define ROWS_MASK    (1u << GPIOA_PIN_KEYBOARD_4 | 1u << GPIOA_PIN_KEYBOARD_5 | \
+                      1u << GPIOA_PIN_KEYBOARD_6 | 1u << GPIOA_PIN_KEYBOARD_7)
+#define COLUMNS_MASK (1u << GPIOA_PIN_KEYBOARD_0 | 1u << GPIOA_PIN_KEYBOARD_1 | \
+                      1u << GPIOA_PIN_KEYBOARD_2 | 1u << GPIOA_PIN_KEYBOARD_3)
+
+#define EVENT_QUEUE_LEN 4u   // power of two
+
+static KEY_Event_t      gEventQueue[EVENT_QUEUE_LEN];
+static volatile uint8_t gEventHead;
+static volatile uint8_t gEventTail;
+static uint16_t         gScanTime_10ms;
 
 static const struct {
 
@@ -101,17 +111,20 @@ KEY_Code_t KEYBOARD_Poll(void)
 
     // *****************
 
-    for (unsigned int j = 0; j < ARRAY_SIZE(keyboard); j++)
+    // Pull all the rows low at once, with nothing pressed every column reads
+    // high and the row by row scan below can be skipped
+    GPIOA->DATA &= ~ROWS_MASK;
+    SYSTICK_DelayUs(1);
+    const bool idle = (GPIOA->DATA & COLUMNS_MASK) == COLUMNS_MASK;
+
+    for (unsigned int j = 0; j < ARRAY_SIZE(keyboard) && !idle; j++)
     {
         uint16_t reg;
         unsigned int i;
         unsigned int k;
 
         // Set all high
-        GPIOA->DATA |=  1u << GPIOA_PIN_KEYBOARD_4 |
-                        1u << GPIOA_PIN_KEYBOARD_5 |
-                        1u << GPIOA_PIN_KEYBOARD_6 |
-                        1u << GPIOA_PIN_KEYBOARD_7;
+        GPIOA->DATA |= ROWS_MASK;
 
         // Clear the pin we are selecting
         GPIOA->DATA &= keyboard[j].set_to_zero_mask;
@@ -151,3 +164,108 @@ KEY_Code_t KEYBOARD_Poll(void)
 
     return Key;
 }
+
+static void PushEvent(KEY_Code_t Key, KEY_EventType_t Type, bool Held)
+{
+    const uint8_t Head = gEventHead;
+
+    if ((uint8_t)(Head - gEventTail) >= EVENT_QUEUE_LEN)
+        return;   // nobody is reading them
+
+    gEventQueue[Head % EVENT_QUEUE_LEN] = (KEY_Event_t){
+        .Key       = Key,
+        .Type      = Type,
+        .Held      = Held,
+        .Time_10ms = gScanTime_10ms,
+    };
+    gEventHead = Head + 1;
+}
+
+// Feed one keypad reading, once every 10ms, and queue the press, hold,
+// repeat and release events it completes
+void KEYBOARD_Update(KEYBOARD_State_t *pState, KEY_Code_t Key, const KEYBOARD_Timing_t *pTiming)
+{
+    gScanTime_10ms++;
+
+    if (pState->Reading0 != Key) // new key pressed
+    {
+        if (pState->Reading0 != KEY_INVALID && Key != KEY_INVALID)
+            PushEvent(pState->Reading1, KEY_EVENT_RELEASE, pState->BeingHeld);  // key pressed without releasing previous key
+
+        pState->Reading0 = Key;
+        pState->Counter  = 0;
+        return;
+    }
+
+    pState->Counter++;
+
+    if (pState->Counter == pTiming->Debounce_10ms) // debounced new key pressed
+    {
+        if (Key == KEY_INVALID) // all keys released
+        {
+            if (pState->Reading1 != KEY_INVALID)
+            {
+                PushEvent(pState->Reading1, KEY_EVENT_RELEASE, pState->BeingHeld);
+                pState->Reading1 = KEY_INVALID;
+            }
+        }
+        else
+        {
+            pState->Reading1 = Key;
+            PushEvent(Key, KEY_EVENT_PRESS, false);
+        }
+
+        pState->BeingHeld = false;
+        return;
+    }
+
+    if (pState->Counter < pTiming->Hold_10ms || Key == KEY_INVALID) // not held long enough yet, or not really pressed
+        return;
+
+    if (pState->Counter == pTiming->Hold_10ms) // initial key repeat with longer delay
+    {
+        if (Key != KEY_PTT)
+        {
+            pState->BeingHeld = true;
+            PushEvent(Key, KEY_EVENT_HOLD, true);
+        }
+    }
+    else // subsequent fast key repeats
+    {
+        if (pTiming->RepeatKeys & (1u << Key))
+        {
+            pState->BeingHeld = true;
+            if ((pState->Counter % pTiming->Repeat_10ms) == 0)
+                PushEvent(Key, KEY_EVENT_REPEAT, true);
+        }
+
+        if (pState->Counter < 0xFFFF)
+            return;
+
+        pState->Counter = pTiming->Hold_10ms + 1;
+    }
+}
+
+bool KEYBOARD_GetEvent(KEY_Event_t *pEvent)
+{
+    const uint8_t Tail = gEventTail;
+
+    if (Tail == gEventHead)
+        return false;
+
+    *pEvent    = gEventQueue[Tail % EVENT_QUEUE_LEN];
+    gEventTail = Tail + 1;
+
+    return true;
+}
+
+// forget the keys seen so far and drop the events nobody read yet
+void KEYBOARD_Reset(KEYBOARD_State_t *pState)
+{
+    pState->Reading0  = KEY_INVALID;
+    pState->Reading1  = KEY_INVALID;
+    pState->Counter   = 0;
+    pState->BeingHeld = false;
+
+    gEventTail = gEventHead;
+}
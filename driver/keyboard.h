@@ -45,12 +45,42 @@ enum KEY_Code_e {
 };
 typedef enum KEY_Code_e KEY_Code_t;
 
-extern KEY_Code_t gKeyReading0;
-extern KEY_Code_t gKeyReading1;
-extern uint16_t   gDebounceCounter;
-extern bool       gWasFKeyPressed;
+enum KEY_EventType_e {
+    KEY_EVENT_PRESS,    // debounced press
+    KEY_EVENT_HOLD,     // held for Hold_10ms
+    KEY_EVENT_REPEAT,   // every Repeat_10ms after that, RepeatKeys only
+    KEY_EVENT_RELEASE
+};
+typedef enum KEY_EventType_e KEY_EventType_t;
+
+typedef struct {
+    KEY_Code_t      Key;
+    KEY_EventType_t Type;
+    bool            Held;       // a hold event was sent for this press
+    uint16_t        Time_10ms;  // keypad scan count when it happened
+} KEY_Event_t;
+
+typedef struct {
+    uint16_t Debounce_10ms;
+    uint16_t Hold_10ms;
+    uint16_t Repeat_10ms;       // MUST be less than Hold_10ms
+    uint32_t RepeatKeys;        // 1 << KEY_x of the keys that auto repeat
+} KEYBOARD_Timing_t;
+
+typedef struct {
+    KEY_Code_t Reading0;        // last raw reading
+    KEY_Code_t Reading1;        // debounced key, KEY_INVALID when none
+    uint16_t   Counter;         // scans since Reading0 last changed
+    bool       BeingHeld;
+} KEYBOARD_State_t;
+
+extern KEYBOARD_State_t gKeyboard;
+extern bool             gWasFKeyPressed;
 
 KEY_Code_t KEYBOARD_Poll(void);
+void       KEYBOARD_Update(KEYBOARD_State_t *pState, KEY_Code_t Key, const KEYBOARD_Timing_t *pTiming);
+bool       KEYBOARD_GetEvent(KEY_Event_t *pEvent);
+void       KEYBOARD_Reset(KEYBOARD_State_t *pState);
 
 #endif
 
@@ -120,6 +120,16 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
     }
 #endif
 
+void ST7565_BlitLineRange(unsigned line, unsigned column, unsigned width)
+{   // a column range of one frame buffer line, for the parts of the screen that refresh on their own
+    if (width == 0)
+        return;
+    SPI_ToggleMasterMode(&SPI0->CR, false);
+    ST7565_WriteByte(0x40);    // start line ?
+    DrawLine(column, line+1, gFrameBuffer[line] + column, width);
+    SPI_ToggleMasterMode(&SPI0->CR, true);
+}
+
 void ST7565_FillScreen(uint8_t value)
 {
     SPI_ToggleMasterMode(&SPI0->CR, false);
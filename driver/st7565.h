@@ -30,6 +30,7 @@ extern uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
 void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const uint8_t *pBitmap, const unsigned int Size);
 void ST7565_BlitFullScreen(void);
 void ST7565_BlitLine(unsigned line);
+void ST7565_BlitLineRange(unsigned line, unsigned column, unsigned width);
 void ST7565_BlitStatusLine(void);
 void ST7565_FillScreen(uint8_t Value);
 void ST7565_Init(void);
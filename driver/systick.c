@@ -17,6 +17,7 @@
 #include "ARMCM0.h"
 #include "systick.h"
 #include "../misc.h"
+#include "../sram-text.h"
 
 // 0x20000324
 static uint32_t gTickMultiplier;
@@ -27,7 +28,7 @@ void SYSTICK_Init(void)
     gTickMultiplier = 48;
 }
 
-void SYSTICK_DelayUs(uint32_t Delay)
+SRAM_TEXT void SYSTICK_DelayUs(uint32_t Delay)
 {
     const uint32_t ticks = Delay * gTickMultiplier;
     uint32_t elapsed_ticks = 0;
@@ -47,3 +48,10 @@ void SYSTICK_DelayUs(uint32_t Delay)
         Previous = Current;
     } while (elapsed_ticks < ticks);
 }
+
+// 0..3, the quarter of the current 10ms tick we are in, for work that has to
+// run more often than the tick without a faster timer
+uint8_t SYSTICK_GetTickQuarter(void)
+{
+    return ((SysTick->LOAD - SysTick->VAL) * 4) / (SysTick->LOAD + 1);
+}
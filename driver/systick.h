@@ -21,6 +21,7 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_DelayUs(uint32_t Delay);
+uint8_t SYSTICK_GetTickQuarter(void);
 
 #endif
 
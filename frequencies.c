@@ -159,118 +159,159 @@ uint32_t FREQUENCY_RoundToStep(uint32_t freq, uint16_t step)
     return (freq + (step + 1) / 2) / step * step;
 }
 
-int32_t TX_freq_check(const uint32_t Frequency)
-{   // return '0' if TX frequency is allowed
-    // otherwise return '-1'
+// TX permission per lock mode, one sorted list of [lower, upper) ranges each,
+// some ranges of the default lock mode further depend on a menu setting
+enum {
+    TX_ALWAYS,
+    TX_IF_200TX,
+    TX_IF_350TX,
+    TX_IF_500TX,
+};
 
-    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
-        return 1;  // not allowed outside this range
+typedef struct {
+    uint32_t lower;
+    uint32_t upper;     // exclusive
+    uint8_t  cond;
+} tx_range_t;
+
+static const tx_range_t tx_ranges_def[] = {
+    {13700000, 17400000, TX_ALWAYS  },
+    {17400000, 35000000, TX_IF_200TX},
+    {35000000, 40000000, TX_IF_350TX},
+    {40000000, 47000000, TX_ALWAYS  },
+    {47000000, 60000001, TX_IF_500TX},
+};
 
-    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
-        return -1;  // BX chip does not work in this range
+static const tx_range_t tx_ranges_fcc[] = {
+    {14400000, 14800000, TX_ALWAYS},
+    {42000000, 45000000, TX_ALWAYS},
+};
 
-    switch (gSetting_F_LOCK)
-    {
-        case F_LOCK_DEF:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
-                return 0;
-            if (Frequency >= frequencyBandTable[BAND4_174MHz].lower && Frequency < frequencyBandTable[BAND4_174MHz].upper)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_200TX)
-            #endif
-                    return 0;
-            if (Frequency >= frequencyBandTable[BAND5_350MHz].lower && Frequency < frequencyBandTable[BAND5_350MHz].upper)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_350TX && gSetting_350EN)
-            #else
-                if (gSetting_350EN)                
-            #endif
-                    return 0;
-            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < frequencyBandTable[BAND6_400MHz].upper)
-                return 0;
-            if (Frequency >= frequencyBandTable[BAND7_470MHz].lower && Frequency <= 60000000)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_500TX)
-            #endif
-                    return 0;
-            break;
-
-        case F_LOCK_FCC:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 42000000 && Frequency < 45000000)
-                return 0;
-            break;
-
-        case F_LOCK_CE:
-            if (Frequency >= 14400000 && Frequency < 14600000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 44000000)
-                return 0;
-            break;
-
-        case F_LOCK_GB:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 44000000)
-                return 0;
-            break;
-
-        case F_LOCK_430:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
-                return 0;
-            if (Frequency >= 40000000 && Frequency < 43000000)
-                return 0;
-            break;
-
-        case F_LOCK_438:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
-                return 0;
-            if (Frequency >= 40000000 && Frequency < 43800000)
-                return 0;
-            break;
+#ifdef ENABLE_FEAT_F4HWN_CA
+static const tx_range_t tx_ranges_ca[] = {
+    {14400000, 14800000, TX_ALWAYS},
+    {43000000, 45000000, TX_ALWAYS},
+};
+#endif
+
+static const tx_range_t tx_ranges_ce[] = {
+    {14400000, 14600000, TX_ALWAYS},
+    {43000000, 44000000, TX_ALWAYS},
+};
+
+static const tx_range_t tx_ranges_gb[] = {
+    {14400000, 14800000, TX_ALWAYS},
+    {43000000, 44000000, TX_ALWAYS},
+};
+
+static const tx_range_t tx_ranges_430[] = {
+    {13700000, 17400000, TX_ALWAYS},
+    {40000000, 43000000, TX_ALWAYS},
+};
+
+static const tx_range_t tx_ranges_438[] = {
+    {13700000, 17400000, TX_ALWAYS},
+    {40000000, 43800000, TX_ALWAYS},
+};
 
 #ifdef ENABLE_FEAT_F4HWN_PMR
-        case F_LOCK_PMR:
-            if (Frequency >= 44600625 && Frequency <= 44619375)
-                return 0;
-            break;
+static const tx_range_t tx_ranges_pmr[] = {
+    {44600625, 44619376, TX_ALWAYS},
+};
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
+// https://forums.radioreference.com/threads/the-great-unofficial-radioreference-frs-gmrs-murs-fact-sheet.275370/
+static const tx_range_t tx_ranges_gmrs_frs_murs[] = {
+    {15182000, 15182001, TX_ALWAYS},    // MURS
+    {15188000, 15188001, TX_ALWAYS},
+    {15194000, 15194001, TX_ALWAYS},
+    {15457000, 15457001, TX_ALWAYS},
+    {15460000, 15460001, TX_ALWAYS},
+    {46255000, 46272501, TX_ALWAYS},    // FRS/GMRS
+    {46755000, 46772501, TX_ALWAYS},
+};
+#endif
+
+// the union of frequencyBandTable[]
+static const tx_range_t tx_ranges_none[] = {
+#ifndef ENABLE_WIDE_RX
+    { 5000000,  7600000, TX_ALWAYS},
+    {10800000, 60000000, TX_ALWAYS},
+#else
+    {BX4819_band1_lower, BX4819_band2_upper, TX_ALWAYS},
 #endif
+};
 
+#define TX_RANGES(table) {table, ARRAY_SIZE(table)}
+
+static const struct {
+    const tx_range_t *ranges;
+    uint8_t           size;
+} tx_lock_table[F_LOCK_LEN] = {
+    [F_LOCK_DEF]           = TX_RANGES(tx_ranges_def),
+    [F_LOCK_FCC]           = TX_RANGES(tx_ranges_fcc),
+#ifdef ENABLE_FEAT_F4HWN_CA
+    [F_LOCK_CA]            = TX_RANGES(tx_ranges_ca),
+#endif
+    [F_LOCK_CE]            = TX_RANGES(tx_ranges_ce),
+    [F_LOCK_GB]            = TX_RANGES(tx_ranges_gb),
+    [F_LOCK_430]           = TX_RANGES(tx_ranges_430),
+    [F_LOCK_438]           = TX_RANGES(tx_ranges_438),
+#ifdef ENABLE_FEAT_F4HWN_PMR
+    [F_LOCK_PMR]           = TX_RANGES(tx_ranges_pmr),
+#endif
 #ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
-        case F_LOCK_GMRS_FRS_MURS:
-            // https://forums.radioreference.com/threads/the-great-unofficial-radioreference-frs-gmrs-murs-fact-sheet.275370/
-            if ((Frequency >= 46255000 && Frequency <= 46272500) ||
-                (Frequency >= 46755000 && Frequency <= 46772500)) // FRS/GMRS
-                return 0;
-            if (Frequency == 15182000 || 
-                Frequency == 15188000 || 
-                Frequency == 15194000 || 
-                Frequency == 15457000 || 
-                Frequency == 15460000) // MURS
-                return 0;
-            break;
+    [F_LOCK_GMRS_FRS_MURS] = TX_RANGES(tx_ranges_gmrs_frs_murs),
 #endif
+    // F_LOCK_ALL has no range at all
+    [F_LOCK_NONE]          = TX_RANGES(tx_ranges_none),
+};
 
-#ifdef ENABLE_FEAT_F4HWN_CA 
-        case F_LOCK_CA:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 45000000)
-                return 0;
-            break;
+static bool TX_RangeEnabled(const uint8_t cond)
+{
+    switch (cond)
+    {
+#ifndef ENABLE_FEAT_F4HWN
+        case TX_IF_200TX: return gSetting_200TX;
+        case TX_IF_350TX: return gSetting_350TX && gSetting_350EN;
+        case TX_IF_500TX: return gSetting_500TX;
+#else
+        case TX_IF_350TX: return gSetting_350EN;
 #endif
+        default:          return true;
+    }
+}
 
-        case F_LOCK_ALL:
-            break;
+int32_t TX_freq_check(const uint32_t Frequency)
+{   // return '0' if TX frequency is allowed
+    // otherwise return '-1'
+
+    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
+        return 1;  // not allowed outside this range
 
-        case F_LOCK_NONE:
-            for (uint32_t i = 0; i < ARRAY_SIZE(frequencyBandTable); i++)
-                if (Frequency >= frequencyBandTable[i].lower && Frequency < frequencyBandTable[i].upper)
-                    return 0;
-            break;
+    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
+        return -1;  // BX chip does not work in this range
+
+    if (gSetting_F_LOCK >= F_LOCK_LEN)
+        return -1;
+
+    // find the last range starting at or below the frequency
+    const tx_range_t *ranges = tx_lock_table[gSetting_F_LOCK].ranges;
+    unsigned int      lo     = 0;
+    unsigned int      hi     = tx_lock_table[gSetting_F_LOCK].size;
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi) / 2;
+        if (ranges[mid].lower <= Frequency)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
 
+    if (lo > 0 && Frequency < ranges[lo - 1].upper && TX_RangeEnabled(ranges[lo - 1].cond))
+        return 0;
+
     // dis-allowed TX frequency
     return -1;
 }
@@ -37,11 +37,33 @@
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
+#include "trace.h"
 #include "ui/status.h"
 #include "ui/ui.h"
 
 FUNCTION_Type_t gCurrentFunction;
 
+volatile uint32_t gFunctionTime_10ms[FUNCTION_N_ELEM];
+volatile uint32_t gPowerSaveAwake_10ms;
+volatile uint16_t gPowerSaveQuiet_500ms;
+
+// typical supply current per function (mA, backlight off), used for the
+// power save statistics and the battery runtime estimate
+static const uint16_t FUNCTION_Current_mA[FUNCTION_N_ELEM] = {
+    [FUNCTION_FOREGROUND] = 60,
+    [FUNCTION_TRANSMIT]   = 1200,
+    [FUNCTION_MONITOR]    = 120,
+    [FUNCTION_INCOMING]   = 120,
+    [FUNCTION_RECEIVE]    = 120,
+    [FUNCTION_POWER_SAVE] = 20,
+    [FUNCTION_BAND_SCOPE] = 60,
+};
+
+uint16_t FUNCTION_GetCurrent_mA(const FUNCTION_Type_t Function)
+{
+    return (Function < FUNCTION_N_ELEM) ? FUNCTION_Current_mA[Function] : 0;
+}
+
 bool FUNCTION_IsRx()
 {
     return gCurrentFunction == FUNCTION_MONITOR ||
@@ -117,19 +139,72 @@ void FUNCTION_Foreground(const FUNCTION_Type_t PreviousFunction)
     gUpdateStatus = true;
 }
 
+// BATTERY_SAVE sets the nominal sleep window, it's halved while the channel
+// has been busy recently and doubled once it has been silent for a long time,
+// never beyond power_save_max_10ms so a carrier is always caught in time
+uint16_t FUNCTION_PowerSaveSleep_10ms(void)
+{
+#ifdef ENABLE_FEAT_F4HWN_SLEEP
+    if (gWakeUp)
+        return gEeprom.BATTERY_SAVE * 200; // deep sleep now indexed on BatSav
+#endif
+
+    const uint16_t sleep_10ms = gEeprom.BATTERY_SAVE * 10;
+
+    if (gPowerSaveQuiet_500ms < power_save_active_500ms)
+        return sleep_10ms / 2;
+
+    if (gPowerSaveQuiet_500ms < power_save_silent_500ms)
+        return sleep_10ms;
+
+    return MIN(sleep_10ms * 2, power_save_max_10ms);
+}
+
+// share of the power save time the BK4819 was awake, in 0.1%
+uint16_t FUNCTION_PowerSaveDutyCycle(void)
+{
+    uint32_t total = gFunctionTime_10ms[FUNCTION_POWER_SAVE];
+    uint32_t awake = gPowerSaveAwake_10ms;
+
+    if (total == 0)
+        return 1000;
+
+    // stay clear of 64 bit divisions
+    while (total > UINT32_MAX / 1000) {
+        total >>= 1;
+        awake >>= 1;
+    }
+
+    return awake * 1000 / total;
+}
+
+// average supply current since boot
+uint16_t FUNCTION_EstimateCurrent_mA(void)
+{
+    uint32_t     total = 0;
+    uint32_t     charge = 0;
+    unsigned int shift = 0;
+
+    for (unsigned int i = 0; i < FUNCTION_N_ELEM; i++)
+        total += gFunctionTime_10ms[i];
+
+    if (total == 0)
+        return 0;
+
+    while ((total >> shift) > UINT32_MAX / 2048)
+        shift++;
+
+    for (unsigned int i = 0; i < FUNCTION_N_ELEM; i++)
+        charge += (gFunctionTime_10ms[i] >> shift) * FUNCTION_Current_mA[i];
+
+    // naps woken up to listen draw RX idle current
+    charge += (gPowerSaveAwake_10ms >> shift) * (FUNCTION_Current_mA[FUNCTION_FOREGROUND] - FUNCTION_Current_mA[FUNCTION_POWER_SAVE]);
+
+    return charge / (total >> shift);
+}
+
 void FUNCTION_PowerSave() {
-    #ifdef ENABLE_FEAT_F4HWN_SLEEP
-        if(gWakeUp)
-        {
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 200; // deep sleep now indexed on BatSav
-        }
-        else
-        {
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-        }
-    #else
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-    #endif
+    gPowerSave_10ms = FUNCTION_PowerSaveSleep_10ms();
     gPowerSaveCountdownExpired = false;
 
     gRxIdleMode = true;
@@ -195,6 +270,8 @@ void FUNCTION_Transmit()
 
     RADIO_SetTxParameters();
 
+    TRACE_FREQ(TRACE_TX_START, gCurrentVfo->pTX->Frequency);
+
     // turn the RED LED on
     BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, true);
 
@@ -249,6 +326,8 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
 
     gCurrentFunction = Function;
 
+    TRACE(TRACE_FUNCTION, PreviousFunction << 8 | Function);
+
     if (bWasPowerSave && Function != FUNCTION_POWER_SAVE) {
         BK4819_Conditional_RX_TurnOn_and_GPIO6_Enable();
         gRxIdleMode = false;
@@ -291,6 +370,9 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
         return;
     }
 
+    if (Function != FUNCTION_BAND_SCOPE)
+        gPowerSaveQuiet_500ms = 0;
+
     if (Function == FUNCTION_TRANSMIT) {
         FUNCTION_Transmit();
     } else if (Function == FUNCTION_MONITOR) {
@@ -35,8 +35,19 @@ typedef enum FUNCTION_Type_t FUNCTION_Type_t;
 
 extern FUNCTION_Type_t       gCurrentFunction;
 
-void FUNCTION_Init(void);
-void FUNCTION_Select(FUNCTION_Type_t Function);
-bool FUNCTION_IsRx();
+// 10ms ticks spent in each function, POWER_SAVE also counts the short RX
+// wake-ups between naps which are tallied separately in gPowerSaveAwake_10ms
+extern volatile uint32_t     gFunctionTime_10ms[FUNCTION_N_ELEM];
+extern volatile uint32_t     gPowerSaveAwake_10ms;
+// time since the last RX/TX activity, drives the power save sleep window
+extern volatile uint16_t     gPowerSaveQuiet_500ms;
+
+void     FUNCTION_Init(void);
+void     FUNCTION_Select(FUNCTION_Type_t Function);
+bool     FUNCTION_IsRx();
+uint16_t FUNCTION_PowerSaveSleep_10ms(void);
+uint16_t FUNCTION_PowerSaveDutyCycle(void);
+uint16_t FUNCTION_EstimateCurrent_mA(void);
+uint16_t FUNCTION_GetCurrent_mA(const FUNCTION_Type_t Function);
 
 #endif
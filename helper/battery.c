@@ -50,6 +50,21 @@ const uint16_t    lowBatteryPeriod = 30;
 
 volatile uint16_t gPowerSave_10ms;
 
+static const uint16_t BATTERY_Capacity_mAh[] = {
+    [BATTERY_TYPE_1600_MAH] = 1600,
+    [BATTERY_TYPE_2200_MAH] = 2200,
+    [BATTERY_TYPE_3500_MAH] = 3500,
+};
+
+#define CHARGE_PER_MAH  360000u     // mA x 10ms
+
+// remaining charge in mA x 10ms, counted down from the per function time
+// and current, re-anchored on the voltage curve when it can't be trusted
+static uint32_t   gBatteryCharge;
+static bool       gBatteryChargeValid;
+static uint32_t   gBatteryChargeTime_10ms[FUNCTION_N_ELEM];
+static uint32_t   gBatteryChargeAwake_10ms;
+
 const uint16_t Voltage2PercentageTable[][7][3] = {
     [BATTERY_TYPE_1600_MAH] = {
         {828, 100},
@@ -105,6 +120,46 @@ unsigned int BATTERY_VoltsToPercent(const unsigned int voltage_10mV)
     return 0;
 }
 
+static void BATTERY_SyncCharge(const unsigned int percent)
+{
+    gBatteryCharge      = BATTERY_Capacity_mAh[gEeprom.BATTERY_TYPE] * percent * (CHARGE_PER_MAH / 100);
+    gBatteryChargeValid = true;
+}
+
+static void BATTERY_CountCharge(void)
+{
+    uint32_t used = 0;
+
+    for (unsigned int i = 0; i < FUNCTION_N_ELEM; i++) {
+        const uint32_t time = gFunctionTime_10ms[i];
+        used += (time - gBatteryChargeTime_10ms[i]) * FUNCTION_GetCurrent_mA(i);
+        gBatteryChargeTime_10ms[i] = time;
+    }
+
+    // naps woken up to listen draw RX idle current
+    const uint32_t awake = gPowerSaveAwake_10ms;
+    used += (awake - gBatteryChargeAwake_10ms) * (FUNCTION_GetCurrent_mA(FUNCTION_FOREGROUND) - FUNCTION_GetCurrent_mA(FUNCTION_POWER_SAVE));
+    gBatteryChargeAwake_10ms = awake;
+
+    if (!gChargingWithTypeC)
+        gBatteryCharge = (used < gBatteryCharge) ? gBatteryCharge - used : 0;
+}
+
+uint16_t BATTERY_RemainingCapacity_mAh(void)
+{
+    return (gBatteryChargeValid && !gChargingWithTypeC) ? gBatteryCharge / CHARGE_PER_MAH : 0;
+}
+
+uint16_t BATTERY_RemainingMinutes(void)
+{
+    const uint16_t current_mA = FUNCTION_EstimateCurrent_mA();
+
+    if (!gBatteryChargeValid || gChargingWithTypeC || current_mA == 0)
+        return 0;
+
+    return MIN(gBatteryCharge / (current_mA * 6000u), (uint32_t)UINT16_MAX);
+}
+
 void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 {
     const uint8_t  PreviousBatteryLevel = gBatteryDisplayLevel;
@@ -163,6 +218,15 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
         gChargingWithTypeC = true;
     }
 
+    {   // anchor the coulomb counter on the voltage curve at start up and while
+        // charging, and again if it drifted too far from it (profiles are typical)
+        const unsigned int percent = BATTERY_VoltsToPercent(gBatteryVoltageAverage);
+        const unsigned int counted = gBatteryCharge / (BATTERY_Capacity_mAh[gEeprom.BATTERY_TYPE] * (CHARGE_PER_MAH / 100));
+
+        if (!gBatteryChargeValid || gChargingWithTypeC || percent + 20 < counted || counted + 20 < percent)
+            BATTERY_SyncCharge(percent);
+    }
+
     if (PreviousBatteryLevel != gBatteryDisplayLevel)
     {
         if(gBatteryDisplayLevel > 2)
@@ -188,6 +252,8 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 
 void BATTERY_TimeSlice500ms(void)
 {
+    BATTERY_CountCharge();
+
     if (!gLowBattery) {
         return;
     }
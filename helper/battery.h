@@ -46,4 +46,9 @@ unsigned int BATTERY_VoltsToPercent(unsigned int voltage_10mV);
 void BATTERY_GetReadings(bool bDisplayBatteryLevel);
 void BATTERY_TimeSlice500ms(void);
 
+// coulomb counted charge left and the runtime it gives at the average
+// current so far, both 0 while unknown (before the first reading, charging)
+uint16_t BATTERY_RemainingCapacity_mAh(void);
+uint16_t BATTERY_RemainingMinutes(void);
+
 #endif
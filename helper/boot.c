@@ -53,10 +53,10 @@ BOOT_Mode_t BOOT_GetMode(void)
 
     if (Keys[0] == Keys[1])
     {
-        gKeyReading0 = Keys[0];
-        gKeyReading1 = Keys[0];
+        gKeyboard.Reading0 = Keys[0];
+        gKeyboard.Reading1 = Keys[0];
 
-        gDebounceCounter = 2;
+        gKeyboard.Counter = 2;
 
         if (Keys[0] == KEY_SIDE1)
             return BOOT_MODE_F_LOCK;
@@ -106,7 +106,7 @@ void BOOT_ProcessMode(BOOT_Mode_t Mode)
             gCurrentVfo = gRxVfo;
 
             RADIO_SetupRegisters(true);
-            BK4819_SetupAircopy();
+            BK4819_SetupAircopy(AIRCOPY_FRAME_WORDS * 2);
             BK4819_ResetFSK();
 
             gAircopyState = AIRCOPY_READY;
@@ -35,6 +35,7 @@ void BSS_Init(void)
     }
 }
 
+// copies the .data image, .sramtext code included, from flash to RAM
 void DATA_Init(void)
 {
     volatile uint32_t *pDataRam   = (volatile uint32_t *)sram_data_start;
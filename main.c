@@ -203,9 +203,7 @@ void Main(void)
             i = (GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT) && KEYBOARD_Poll() == KEY_INVALID) ? i + 1 : 0;
             SYSTEM_DelayMs(10);
         }
-        gKeyReading0 = KEY_INVALID;
-        gKeyReading1 = KEY_INVALID;
-        gDebounceCounter = 0;
+        KEYBOARD_Reset(&gKeyboard);
     }
 
     if (!gChargingWithTypeC && gBatteryDisplayLevel == 0)
@@ -255,9 +253,7 @@ void Main(void)
                 i = (GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT) && KEYBOARD_Poll() == KEY_INVALID) ? i + 1 : 0;
                 SYSTEM_DelayMs(10);
             }
-            gKeyReading0 = KEY_INVALID;
-            gKeyReading1 = KEY_INVALID;
-            gDebounceCounter = 0;
+            KEYBOARD_Reset(&gKeyboard);
         }
 #endif
 
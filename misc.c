@@ -38,9 +38,12 @@ const uint8_t     DTMF_txstop_countdown_500ms      =  3000 / 500;  // 6 seconds
 
 const uint8_t     key_input_timeout_500ms          =  8000 / 500;  // 8 seconds
 
-const uint16_t    key_repeat_delay_10ms            =   400 / 10;   // 400ms
-const uint16_t    key_repeat_10ms                  =    80 / 10;   // 80ms .. MUST be less than 'key_repeat_delay'
-const uint16_t    key_debounce_10ms                =    20 / 10;   // 20ms
+const KEYBOARD_Timing_t key_timing = {
+    .Debounce_10ms = 20 / 10,     // 20ms
+    .Hold_10ms     = 400 / 10,    // 400ms
+    .Repeat_10ms   = 80 / 10,     // 80ms .. MUST be less than 'Hold_10ms'
+    .RepeatKeys    = 1u << KEY_UP | 1u << KEY_DOWN,
+};
 
 const uint8_t     scan_delay_10ms                  =   210 / 10;   // 210ms
 
@@ -75,6 +78,9 @@ const uint16_t    battery_save_count_10ms          = 10000 / 10;   // 10 seconds
 
 const uint16_t    power_save1_10ms                 =   100 / 10;   // 100ms
 const uint16_t    power_save2_10ms                 =   200 / 10;   // 200ms
+const uint16_t    power_save_max_10ms              =  1000 / 10;   // 1 second .. worst case sleep before we listen again
+const uint16_t    power_save_active_500ms          = 30000 / 500;  // 30 seconds since last RX/TX .. short naps
+const uint16_t    power_save_silent_500ms          = 300000 / 500; // 5 minutes since last RX/TX .. long naps
 
 #ifdef ENABLE_VOX
     const uint16_t    vox_stop_count_down_10ms         =  1000 / 10;   // 1 second
@@ -20,6 +20,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "driver/keyboard.h"
+
 #ifndef ARRAY_SIZE
     #define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
 #endif
@@ -98,9 +100,7 @@ extern const uint8_t         DTMF_txstop_countdown_500ms;
 
 extern const uint8_t         key_input_timeout_500ms;
 
-extern const uint16_t        key_repeat_delay_10ms;
-extern const uint16_t        key_repeat_10ms;
-extern const uint16_t        key_debounce_10ms;
+extern const KEYBOARD_Timing_t key_timing;
 
 extern const uint8_t         scan_delay_10ms;
 
@@ -108,6 +108,9 @@ extern const uint16_t        battery_save_count_10ms;
 
 extern const uint16_t        power_save1_10ms;
 extern const uint16_t        power_save2_10ms;
+extern const uint16_t        power_save_max_10ms;
+extern const uint16_t        power_save_active_500ms;
+extern const uint16_t        power_save_silent_500ms;
 
 #ifdef ENABLE_VOX
     extern const uint16_t    vox_stop_count_down_10ms;
@@ -354,6 +357,7 @@ extern uint8_t               gFSKWriteIndex;
     extern bool              gIsNoaaMode;
     extern uint8_t           gNoaaChannel;
 #endif
+extern volatile uint32_t     gGlobalSysTickCounter;
 extern volatile bool         gNextTimeslice;
 extern bool                  gUpdateDisplay;
 extern bool                  gF_LOCK;
@@ -452,8 +452,10 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
     // *******************************
     // squelch
 
+    const SETTINGS_Calibration_t *pCal = SETTINGS_GetCalibration();
+
     FREQUENCY_Band_t Band = FREQUENCY_GetBand(pInfo->pRX->Frequency);
-    uint16_t Base = (Band < BAND4_174MHz) ? 0x1E60 : 0x1E00;
+    const uint8_t (*pSquelch)[16] = pCal->squelch[(Band < BAND4_174MHz) ? 1 : 0];  // 1E60 : 1E00
 
     if (gEeprom.SQUELCH_LEVEL == 0)
     {   // squelch == 0 (off)
@@ -467,16 +469,16 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
     }
     else
     {   // squelch >= 1
-        Base += gEeprom.SQUELCH_LEVEL;                                        // my eeprom squelch-1
+        const uint8_t Level = gEeprom.SQUELCH_LEVEL;                          // my eeprom squelch-1
                                                                               // VHF   UHF
-        EEPROM_ReadBuffer(Base + 0x00, &pInfo->SquelchOpenRSSIThresh,    1);  //  50    10
-        EEPROM_ReadBuffer(Base + 0x10, &pInfo->SquelchCloseRSSIThresh,   1);  //  40     5
+        pInfo->SquelchOpenRSSIThresh    = pSquelch[0][Level];                 //  50    10
+        pInfo->SquelchCloseRSSIThresh   = pSquelch[1][Level];                 //  40     5
 
-        EEPROM_ReadBuffer(Base + 0x20, &pInfo->SquelchOpenNoiseThresh,   1);  //  65    90
-        EEPROM_ReadBuffer(Base + 0x30, &pInfo->SquelchCloseNoiseThresh,  1);  //  70   100
+        pInfo->SquelchOpenNoiseThresh   = pSquelch[2][Level];                 //  65    90
+        pInfo->SquelchCloseNoiseThresh  = pSquelch[3][Level];                 //  70   100
 
-        EEPROM_ReadBuffer(Base + 0x40, &pInfo->SquelchCloseGlitchThresh, 1);  //  90    90
-        EEPROM_ReadBuffer(Base + 0x50, &pInfo->SquelchOpenGlitchThresh,  1);  // 100   100
+        pInfo->SquelchCloseGlitchThresh = pSquelch[4][Level];                 //  90    90
+        pInfo->SquelchOpenGlitchThresh  = pSquelch[5][Level];                 // 100   100
 
 
         uint16_t noise_open   = pInfo->SquelchOpenNoiseThresh;
@@ -555,7 +557,7 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
         currentPower--;
     }
 
-    EEPROM_ReadBuffer(0x1ED0 + (Band * 16) + (Op * 3), Txp, 3);
+    memcpy(Txp, pCal->txp[Band][Op], 3);
 
 #ifdef ENABLE_FEAT_F4HWN
     // make low and mid even lower
@@ -877,6 +879,31 @@ void RADIO_SetupRegisters(bool switchToForeground)
         FUNCTION_Select(FUNCTION_FOREGROUND);
 }
 
+// Frequency only retune of gRxVfo for the frequency scanner, everything else
+// RADIO_SetupRegisters() programmed (filter bandwidth, CSS, AGC, interrupts,
+// audio path) stays as it is. The squelch thresholds and the LNA path are only
+// rewritten when the step crossed the edge they depend on.
+void RADIO_RetuneRX(const uint32_t PrevFrequency)
+{
+    const uint32_t Frequency = gRxVfo->pRX->Frequency;
+
+    if (gCurrentFunction != FUNCTION_FOREGROUND) {
+        // receiving or monitoring, the audio path has to be shut down too
+        RADIO_SetupRegisters(true);
+        return;
+    }
+
+    if ((FREQUENCY_GetBand(Frequency) < BAND4_174MHz) != (FREQUENCY_GetBand(PrevFrequency) < BAND4_174MHz))
+        BK4819_SetupSquelch(
+            gRxVfo->SquelchOpenRSSIThresh,    gRxVfo->SquelchCloseRSSIThresh,
+            gRxVfo->SquelchOpenNoiseThresh,   gRxVfo->SquelchCloseNoiseThresh,
+            gRxVfo->SquelchCloseGlitchThresh, gRxVfo->SquelchOpenGlitchThresh);
+
+    BK4819_RetuneRX(Frequency, (Frequency < 28000000) != (PrevFrequency < 28000000));
+
+    FUNCTION_Init();
+}
+
 #ifdef ENABLE_NOAA
     void RADIO_ConfigureNOAA(void)
     {
@@ -1036,6 +1063,14 @@ void RADIO_SetupAGC(bool listeningAM, bool disable)
     lastSettings = newSettings;
 
 
+#ifdef ENABLE_SOFT_AGC
+    if(gSetting_AM_fix) { // software AGC regulates every modulation, keep the chip AGC on its fixed entry
+        BK4819_SetAGC(0);
+        AM_fix_enable(!disable);
+        return;
+    }
+#endif
+
     if(!listeningAM) { // if not actively listening AM we don't need any AM specific regulation
         BK4819_SetAGC(!disable);
         BK4819_InitAGC(false);
@@ -1221,7 +1256,7 @@ void RADIO_SendCssTail(void)
 #ifdef ENABLE_CW
 void RADIO_TransmitCwID(void)
 {
-    CW_Transmit_String(gCWSettings.callsign);
+    CW_Transmit_String(gCWSettings.callsign, gCWSettings.wpm);
 }
 #endif
 
@@ -158,6 +158,7 @@ void     RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo);
 void     RADIO_ApplyOffset(VFO_Info_t *pInfo);
 void     RADIO_SelectVfos(void);
 void     RADIO_SetupRegisters(bool switchToForeground);
+void     RADIO_RetuneRX(const uint32_t PrevFrequency);
 #ifdef ENABLE_NOAA
     void RADIO_ConfigureNOAA(void);
 #endif
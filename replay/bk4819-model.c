@@ -0,0 +1,170 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// BK4819 model, stands in for driver/bk4819-bus.c
+//
+// - a register the host build has written reads back what it wrote
+// - any other register reads what the radio read at that time in the
+//   capture, the last value before now (the capture leaves out reads that
+//   did not change)
+// - interrupts are raised at the times the capture read them out of REG_02:
+//   REG_0C bit 0 is set while one is due, writing REG_02 clears the request
+//   and latches the status for the next REG_02 read
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "driver/bk4819.h"
+#include "replay/replay.h"
+
+// bus time of one access, the bit-banged transfer takes about 3us a bit
+#define READ_COUNTS   REPLAY_US(59)
+#define WRITE_COUNTS  REPLAY_US(76)
+
+typedef struct {
+    uint64_t Time;
+    uint16_t Value;
+} Sample_t;
+
+typedef struct {
+    Sample_t *pSamples;
+    size_t    Count;
+    size_t    Next;       // first sample still in the future
+    bool      Written;    // by the host build, reads come from Value from then on
+    uint16_t  Value;
+} Register_t;
+
+static Register_t gRegisters[0x80];
+
+static Sample_t  *gInterrupts;
+static size_t     gInterruptCount;
+static size_t     gInterruptNext;
+static uint16_t   gInterruptStatus;   // latched by the last REG_02 write
+
+REPLAY_Write_t *gReplayWrites;
+size_t          gReplayWriteCount;
+uint32_t        gReplayReadsCaptured;
+uint32_t        gReplayReadsUnknown;
+uint32_t        gReplayInterrupts;
+
+static size_t   gWriteSize;
+
+static void *Grow(void *p, size_t *pSize, size_t Count, size_t Element)
+{
+    if (Count < *pSize)
+        return p;
+    *pSize = *pSize ? *pSize * 2 : 1024;
+    p = realloc(p, *pSize * Element);
+    if (p == NULL) {
+        perror("replay");
+        exit(1);
+    }
+    return p;
+}
+
+void MODEL_Init(const REPLAY_Event_t *pEvents, size_t Count)
+{
+    size_t Sizes[0x80] = {0};
+    size_t InterruptSize = 0;
+
+    for (size_t i = 0; i < Count; i++) {
+        const REPLAY_Event_t *e = &pEvents[i];
+        if (e->Id != TRACE_BK4819_READ)
+            continue;
+
+        const Sample_t s = {REPLAY_EventTime(e->Time), e->Arg};
+        const uint8_t  r = e->Aux & 0x7F;
+
+        if (r == BK4819_REG_02) {
+            // a read of 0 is the firmware clearing out, nothing was pending
+            if (s.Value != 0) {
+                gInterrupts = Grow(gInterrupts, &InterruptSize, gInterruptCount, sizeof(Sample_t));
+                gInterrupts[gInterruptCount++] = s;
+            }
+            continue;
+        }
+
+        Register_t *pReg = &gRegisters[r];
+        pReg->pSamples = Grow(pReg->pSamples, &Sizes[r], pReg->Count, sizeof(Sample_t));
+        pReg->pSamples[pReg->Count++] = s;
+    }
+}
+
+static uint16_t Captured(Register_t *pReg)
+{
+    while (pReg->Next < pReg->Count && pReg->pSamples[pReg->Next].Time <= gReplayNow)
+        pReg->Next++;
+
+    // before the first sample the register already held what it read then
+    return pReg->pSamples[pReg->Next ? pReg->Next - 1 : 0].Value;
+}
+
+static bool InterruptDue(void)
+{
+    return gInterruptNext < gInterruptCount && gInterrupts[gInterruptNext].Time <= gReplayNow;
+}
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    Register_t *pReg = &gRegisters[Register & 0x7F];
+    uint16_t    Value;
+
+    REPLAY_Advance(READ_COUNTS);
+
+    if (Register == BK4819_REG_02) {
+        Value            = gInterruptStatus;
+        gInterruptStatus = 0;
+        return Value;
+    }
+
+    if (pReg->Written && Register != BK4819_REG_0C) {
+        Value = pReg->Value;
+    }
+    else if (pReg->Count > 0) {
+        Value = Captured(pReg);
+        gReplayReadsCaptured++;
+    }
+    else {
+        Value = pReg->Value;
+        gReplayReadsUnknown++;
+    }
+
+    if (Register == BK4819_REG_0C)
+        Value = (Value & ~1u) | InterruptDue();
+
+    return Value;
+}
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    Register_t *pReg = &gRegisters[Register & 0x7F];
+
+    REPLAY_Advance(WRITE_COUNTS);
+
+    pReg->Written = true;
+    pReg->Value   = Data;
+
+    if ((Register & 0x7F) == BK4819_REG_02) {
+        while (InterruptDue()) {
+            gInterruptStatus |= gInterrupts[gInterruptNext++].Value;
+            gReplayInterrupts++;
+        }
+    }
+
+    gReplayWrites = Grow(gReplayWrites, &gWriteSize, gReplayWriteCount, sizeof(REPLAY_Write_t));
+    gReplayWrites[gReplayWriteCount++] = (REPLAY_Write_t){gReplayNow, Register & 0x7F, Data};
+}
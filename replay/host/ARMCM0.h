@@ -0,0 +1,43 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host stand-in for the CMSIS device header: the replay keeps SysTick in
+// step with its virtual clock and there are no interrupts to mask
+
+#ifndef ARMCM0_H
+#define ARMCM0_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type gReplaySysTick;
+
+#define SysTick (&gReplaySysTick)
+
+static inline void     __disable_irq(void) {}
+static inline void     __enable_irq(void) {}
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void     __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+
+void NVIC_SystemReset(void);   // ends the replay
+
+#endif
@@ -0,0 +1,373 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host replay of a BK4819 register capture
+//
+// the firmware runs on a virtual clock against bk4819-model.c, which serves
+// what the radio read during the capture, and what it writes to the chip is
+// compared with what the radio wrote; the summary is JSON like the bench's
+// so two builds of an algorithm can be compared on the same session
+
+#define _GNU_SOURCE   // MAP_FIXED_NOREPLACE
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "ARMCM0.h"
+#include "am_fix.h"
+#include "app/app.h"
+#include "app/dtmf.h"
+#include "app/spectrum.h"
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+#include "helper/battery.h"
+#include "misc.h"
+#include "radio.h"
+#include "replay/replay.h"
+#include "settings.h"
+#include "ui/menu.h"
+#include "ui/ui.h"
+
+// main loop pass without any bus traffic
+#define LOOP_COUNTS    REPLAY_US(20)
+// captured and replayed writes further apart than this are not paired
+#define MATCH_WINDOW   32                    // writes
+#define MATCH_SKEW     REPLAY_US(100000)
+
+extern uint8_t gReplayEeprom[0x2000];
+
+void SystickHandler(void);
+
+uint64_t gReplayNow;
+uint64_t gReplayEnd;
+
+static bool     gClockRunning;
+static jmp_buf  gEndOfCapture;
+
+static REPLAY_Event_t *gEvents;
+static size_t          gEventCount;
+
+uint64_t REPLAY_EventTime(uint32_t Time)
+{
+    return (uint64_t)(Time >> 12) * REPLAY_TICK + (Time & 0xFFF) * 128u;
+}
+
+uint32_t REPLAY_TraceTime(uint64_t Time)
+{
+    return (uint32_t)(Time / REPLAY_TICK) << 12 | (uint32_t)(Time % REPLAY_TICK) >> 7;
+}
+
+void REPLAY_Advance(uint64_t Counts)
+{
+    if (!gClockRunning)
+        return;
+
+    while (Counts > 0) {
+        const uint64_t ToTick = REPLAY_TICK - gReplayNow % REPLAY_TICK;
+        const uint64_t Step   = Counts < ToTick ? Counts : ToTick;
+
+        gReplayNow += Step;
+        Counts     -= Step;
+
+        SysTick->VAL = SysTick->LOAD - gReplayNow % REPLAY_TICK;
+        if (gReplayNow % REPLAY_TICK == 0)
+            SystickHandler();
+    }
+
+    if (gReplayNow >= gReplayEnd)
+        longjmp(gEndOfCapture, 1);
+}
+
+void NVIC_SystemReset(void)
+{
+    longjmp(gEndOfCapture, 1);
+}
+
+static void *ReadFile(const char *pPath, size_t *pSize)
+{
+    FILE *f = fopen(pPath, "rb");
+    if (f == NULL) {
+        perror(pPath);
+        exit(1);
+    }
+
+    fseek(f, 0, SEEK_END);
+    *pSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    void *p = malloc(*pSize ? *pSize : 1);
+    if (p == NULL || fread(p, 1, *pSize, f) != *pSize) {
+        perror(pPath);
+        exit(1);
+    }
+
+    fclose(f);
+    return p;
+}
+
+static void MapPeripherals(void)
+{
+    // the firmware reads and writes GPIO, PORTCON and PWM registers directly,
+    // give it RAM at their addresses with no key pressed and PTT released
+    void *p = mmap((void *)0x40000000, 0xC0000, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)0x40000000) {
+        perror("replay: mapping the peripherals");
+        exit(1);
+    }
+
+    GPIOA->DATA = 0xFFFF;
+    GPIOC->DATA = 1u << GPIOC_PIN_PTT;
+}
+
+static void Boot(void)
+{
+    // main.c less the hardware set up, the welcome screen and the key waits
+    memset(gDTMF_String, '-', sizeof(gDTMF_String));
+    gDTMF_String[sizeof(gDTMF_String) - 1] = 0;
+
+    SETTINGS_InitEEPROM();
+#ifdef ENABLE_FEAT_F4HWN
+    gDW = gEeprom.DUAL_WATCH;
+    gCB = gEeprom.CROSS_BAND_RX_TX;
+#endif
+    SETTINGS_LoadCalibration();
+
+    RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
+    RADIO_ConfigureChannel(1, VFO_CONFIGURE_RELOAD);
+    RADIO_SelectVfos();
+    RADIO_SetupRegisters(true);
+
+    for (unsigned int i = 0; i < ARRAY_SIZE(gBatteryVoltages); i++)
+        BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[i], &gBatteryCurrent);
+    BATTERY_GetReadings(false);
+
+#ifdef ENABLE_AM_FIX
+    AM_fix_init();
+#endif
+
+    gMenuListCount = 0;
+    while (MenuList[gMenuListCount].name[0] != '\0' && MenuList[gMenuListCount].menu_id != FIRST_HIDDEN_MENU_ITEM)
+        gMenuListCount++;
+
+    gUpdateStatus = true;
+}
+
+static void RunApp(void)
+{
+    while (true) {
+        APP_Update();
+
+        if (gNextTimeslice) {
+            APP_TimeSlice10ms();
+
+            if (gNextTimeslice_500ms)
+                APP_TimeSlice500ms();
+        }
+
+        REPLAY_Advance(LOOP_COUNTS);
+    }
+}
+
+#ifdef ENABLE_AM_FIX
+static void RunAmFix(void)
+{
+    // the fix alone, as the 10ms tick runs it on an AM channel
+    while (true) {
+        AM_fix_10ms(gEeprom.RX_VFO, MODULATION_AM);
+        REPLAY_Advance(REPLAY_TICK - gReplayNow % REPLAY_TICK);
+    }
+}
+#endif
+
+// runs until the end of the capture
+static bool Run(const char *pTarget)
+{
+    if (setjmp(gEndOfCapture) != 0)
+        return true;
+
+    if (strcmp(pTarget, "app") == 0)
+        RunApp();
+#ifdef ENABLE_SPECTRUM
+    else if (strcmp(pTarget, "spectrum") == 0) {
+        APP_RunSpectrum();
+        RunApp();
+    }
+#endif
+#ifdef ENABLE_AM_FIX
+    else if (strcmp(pTarget, "am_fix") == 0)
+        RunAmFix();
+#endif
+
+    return false;
+}
+
+static void WriteTrace(const char *pPath, uint64_t Start)
+{
+    FILE *f = fopen(pPath, "wb");
+    if (f == NULL) {
+        perror(pPath);
+        exit(1);
+    }
+
+    uint32_t Seq = 0;
+    for (size_t i = 0; i < gReplayWriteCount; i++) {
+        const REPLAY_Write_t *w = &gReplayWrites[i];
+        if (w->Time < Start)
+            continue;
+        const REPLAY_Event_t e = {Seq++, REPLAY_TraceTime(w->Time), TRACE_BK4819_WRITE, w->Register, w->Value};
+        fwrite(&e, sizeof(e), 1, f);
+    }
+
+    fclose(f);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pCapture = NULL;
+    const char *pEeprom  = NULL;
+    const char *pWrites  = NULL;
+    const char *pTarget  = "app";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--target") == 0 && i + 1 < argc)
+            pTarget = argv[++i];
+        else if (strcmp(argv[i], "--eeprom") == 0 && i + 1 < argc)
+            pEeprom = argv[++i];
+        else if (strcmp(argv[i], "--writes") == 0 && i + 1 < argc)
+            pWrites = argv[++i];
+        else if (argv[i][0] != '-' && pCapture == NULL)
+            pCapture = argv[i];
+        else
+            pCapture = NULL, argc = 0;
+    }
+
+    if (pCapture == NULL) {
+        fprintf(stderr, "usage: replay CAPTURE [--target app|spectrum|am_fix] [--eeprom IMAGE] [--writes FILE]\n");
+        return 1;
+    }
+
+    size_t Size;
+    gEvents     = ReadFile(pCapture, &Size);
+    gEventCount = Size / sizeof(REPLAY_Event_t);
+    if (gEventCount == 0) {
+        fprintf(stderr, "%s: empty capture\n", pCapture);
+        return 1;
+    }
+
+    memset(gReplayEeprom, 0xFF, sizeof(gReplayEeprom));
+    if (pEeprom != NULL) {
+        uint8_t *pImage = ReadFile(pEeprom, &Size);
+        memcpy(gReplayEeprom, pImage, Size < sizeof(gReplayEeprom) ? Size : sizeof(gReplayEeprom));
+        free(pImage);
+    }
+
+    MapPeripherals();
+    MODEL_Init(gEvents, gEventCount);
+
+    uint32_t Lost = 0;
+    for (size_t i = 1; i < gEventCount; i++)
+        Lost += gEvents[i].Seq - gEvents[i - 1].Seq - 1;
+
+    // boot with the clock stopped, the capture starts with the radio already up
+    Boot();
+
+    const size_t   BootWrites = gReplayWriteCount;
+    const uint64_t Start      = REPLAY_EventTime(gEvents[0].Time);
+
+    gReplayNow            = Start;
+    gReplayEnd            = REPLAY_EventTime(gEvents[gEventCount - 1].Time) + REPLAY_TICK;
+    gGlobalSysTickCounter = Start / REPLAY_TICK;
+    SysTick->VAL          = SysTick->LOAD - Start % REPLAY_TICK;
+    gClockRunning         = true;
+
+    if (!Run(pTarget)) {
+        fprintf(stderr, "unknown target %s\n", pTarget);
+        return 1;
+    }
+    gClockRunning = false;
+
+    // pair the writes in order, a pair may be a few writes apart on either side
+    size_t   CapturedWrites = 0;
+    size_t   Matched        = 0;
+    uint64_t SkewSum        = 0;
+    uint64_t SkewMax        = 0;
+    uint64_t Divergence     = 0;
+    size_t   Next           = 0;
+
+    for (size_t i = 0; i < gEventCount; i++)
+        CapturedWrites += gEvents[i].Id == TRACE_BK4819_WRITE;
+
+    for (size_t i = BootWrites; i < gReplayWriteCount; i++) {
+        const REPLAY_Write_t *w = &gReplayWrites[i];
+        size_t j, Seen;
+
+        for (j = Next, Seen = 0; j < gEventCount && Seen < MATCH_WINDOW; j++) {
+            const REPLAY_Event_t *e = &gEvents[j];
+            if (e->Id != TRACE_BK4819_WRITE)
+                continue;
+            if (REPLAY_EventTime(e->Time) > w->Time + MATCH_SKEW) {
+                Seen = MATCH_WINDOW;
+                break;
+            }
+            if (e->Aux == w->Register && e->Arg == w->Value)
+                break;
+            Seen++;
+        }
+
+        const uint64_t t    = j < gEventCount ? REPLAY_EventTime(gEvents[j].Time) : 0;
+        const uint64_t Skew = w->Time > t ? w->Time - t : t - w->Time;
+
+        if (j < gEventCount && Seen < MATCH_WINDOW && Skew <= MATCH_SKEW) {
+            SkewSum += Skew;
+            if (Skew > SkewMax)
+                SkewMax = Skew;
+            Matched++;
+            Next = j + 1;
+        }
+        else if (Divergence == 0) {
+            Divergence = w->Time;
+        }
+    }
+
+    if (pWrites != NULL)
+        WriteTrace(pWrites, Start);
+
+    fprintf(stdout, "{\n");
+    fprintf(stdout, "  \"capture\": \"%s\",\n", pCapture);
+    fprintf(stdout, "  \"target\": \"%s\",\n", pTarget);
+    fprintf(stdout, "  \"duration_ms\": %.1f,\n", (double)(gReplayNow - Start) / REPLAY_US(1000));
+    fprintf(stdout, "  \"events\": %zu,\n", gEventCount);
+    fprintf(stdout, "  \"events_lost\": %u,\n", Lost);
+    fprintf(stdout, "  \"interrupts\": %u,\n", gReplayInterrupts);
+    fprintf(stdout, "  \"reads_captured\": %u,\n", gReplayReadsCaptured);
+    fprintf(stdout, "  \"reads_unknown\": %u,\n", gReplayReadsUnknown);
+    fprintf(stdout, "  \"writes_captured\": %zu,\n", CapturedWrites);
+    fprintf(stdout, "  \"writes_replayed\": %zu,\n", gReplayWriteCount - BootWrites);
+    fprintf(stdout, "  \"writes_matched\": %zu,\n", Matched);
+    fprintf(stdout, "  \"skew_mean_us\": %.1f,\n", Matched ? (double)SkewSum / Matched / 48 : 0.0);
+    fprintf(stdout, "  \"skew_max_us\": %.1f,\n", (double)SkewMax / 48);
+    if (Divergence)
+        fprintf(stdout, "  \"first_divergence_ms\": %.3f\n", (double)(Divergence - Start) / REPLAY_US(1000));
+    else
+        fprintf(stdout, "  \"first_divergence_ms\": null\n");
+    fprintf(stdout, "}\n");
+
+    return 0;
+}
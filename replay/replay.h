@@ -0,0 +1,60 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "trace.h"
+
+// the radio's clock, in 48MHz SysTick counts, runs only when the firmware
+// spends time: on the register bus, in delays and once per main loop pass
+#define REPLAY_TICK      480000u           // one 10ms SysTick period
+#define REPLAY_US(us)    ((uint64_t)(us) * 48u)
+
+// a record of a capture saved by trace-dump.py
+typedef struct __attribute__((packed)) {
+    uint32_t Seq;
+    uint32_t Time;    // TRACE_Entry_t stamp: 10ms ticks << 12 | counts / 128
+    uint8_t  Id;
+    uint8_t  Aux;
+    uint16_t Arg;
+} REPLAY_Event_t;
+
+typedef struct {
+    uint64_t Time;    // SysTick counts
+    uint8_t  Register;
+    uint16_t Value;
+} REPLAY_Write_t;
+
+extern uint64_t        gReplayNow;
+extern uint64_t        gReplayEnd;
+
+extern REPLAY_Write_t *gReplayWrites;      // what the host build wrote
+extern size_t          gReplayWriteCount;
+extern uint32_t        gReplayReadsCaptured;
+extern uint32_t        gReplayReadsUnknown;
+extern uint32_t        gReplayInterrupts;
+
+uint64_t REPLAY_EventTime(uint32_t Time);
+uint32_t REPLAY_TraceTime(uint64_t Time);
+void     REPLAY_Advance(uint64_t Counts);
+
+void     MODEL_Init(const REPLAY_Event_t *pEvents, size_t Count);
+
+#endif
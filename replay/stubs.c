@@ -0,0 +1,137 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// host replacements for the rest of the hardware the replayed sources use,
+// anything that takes time on the radio takes it on the virtual clock
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "ARMCM0.h"
+#include "board.h"
+#include "driver/crc.h"
+#include "driver/eeprom.h"
+#include "driver/i2c.h"
+#include "driver/st7565.h"
+#include "driver/system.h"
+#include "driver/systick.h"
+#include "driver/uart.h"
+#include "helper/battery.h"
+#include "replay/replay.h"
+
+SysTick_Type gReplaySysTick = {.LOAD = REPLAY_TICK - 1, .VAL = REPLAY_TICK - 1};
+
+uint8_t      gStatusLine[LCD_WIDTH];
+uint8_t      gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+
+uint8_t      gReplayEeprom[0x2000];
+
+#ifdef ENABLE_UART
+    uint8_t  UART_DMA_Buffer[256];
+#endif
+
+// timing
+
+void SYSTEM_DelayMs(uint32_t Delay)
+{
+    REPLAY_Advance(REPLAY_US(Delay * 1000));
+}
+
+void SYSTICK_DelayUs(uint32_t Delay)
+{
+    REPLAY_Advance(REPLAY_US(Delay));
+}
+
+uint8_t SYSTICK_GetTickQuarter(void)
+{
+    return ((SysTick->LOAD - SysTick->VAL) * 4) / (SysTick->LOAD + 1);
+}
+
+// display, a full frame is about 8ms of SPI on the radio
+
+void ST7565_BlitFullScreen(void) { REPLAY_Advance(REPLAY_US(8000)); }
+void ST7565_BlitStatusLine(void) { REPLAY_Advance(REPLAY_US(1000)); }
+void ST7565_BlitLine(unsigned line) { (void)line; REPLAY_Advance(REPLAY_US(1000)); }
+void ST7565_BlitLineRange(unsigned line, unsigned column, unsigned width) { (void)line; (void)column; REPLAY_Advance(REPLAY_US(width * 8)); }
+void ST7565_FillScreen(uint8_t value) { memset(gFrameBuffer, value, sizeof(gFrameBuffer)); }
+void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const uint8_t *pBitmap, const unsigned int Size) { (void)Column; (void)Line; (void)pBitmap; (void)Size; }
+void ST7565_Init(void) {}
+void ST7565_FixInterfGlitch(void) {}
+void ST7565_HardwareReset(void) {}
+#ifdef ENABLE_FEAT_F4HWN_SLEEP
+    void ST7565_ShutDown(void) {}
+#endif
+void ST7565_SelectColumnAndLine(uint8_t Column, uint8_t Line) { (void)Column; (void)Line; }
+void ST7565_WriteByte(uint8_t Value) { (void)Value; }
+#ifdef ENABLE_FEAT_F4HWN
+    void ST7565_ContrastAndInv(void) {}
+    void ST7565_Gauge(uint8_t line, uint8_t min, uint8_t max, uint8_t value) { (void)line; (void)min; (void)max; (void)value; }
+    int16_t map(int16_t x, int16_t in_min, int16_t in_max, int16_t out_min, int16_t out_max) {
+        return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+    }
+#endif
+
+// EEPROM, the image given with --eeprom or blank, a page write takes 8ms
+
+void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
+{
+    memcpy(pBuffer, &gReplayEeprom[Address % sizeof(gReplayEeprom)], Size);
+}
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+    if (pBuffer == NULL || Address >= sizeof(gReplayEeprom) - 8 || memcmp(&gReplayEeprom[Address], pBuffer, 8) == 0)
+        return;
+    memcpy(&gReplayEeprom[Address], pBuffer, 8);
+    SYSTEM_DelayMs(8);
+}
+
+// the keypad shares its pins with the I2C bus
+void I2C_Start(void) {}
+void I2C_Stop(void) {}
+
+// the rest
+
+void BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
+{
+    *pVoltage = gBatteryCalibration[3];   // reads 7.6V
+    *pCurrent = 0;
+}
+
+void UART_Send(const void *pBuffer, uint32_t Size) { (void)pBuffer; (void)Size; }
+void UART_LogSend(const void *pBuffer, uint32_t Size) { (void)pBuffer; (void)Size; }
+#ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
+    bool UART_IsCableConnected(void) { return false; }
+#endif
+
+uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size)
+{
+    const uint8_t *pData = pBuffer;
+    uint16_t       Crc   = 0;
+
+    while (Size--) {
+        Crc ^= *pData++ << 8;
+        for (unsigned int i = 0; i < 8; i++)
+            Crc = (Crc & 0x8000) ? (Crc << 1) ^ 0x1021 : Crc << 1;
+    }
+    return Crc;
+}
+
+// printf back end, nothing the replay runs prints through it
+void _putchar(char c)
+{
+    (void)c;
+}
@@ -20,10 +20,12 @@
 #endif
 #include "app/scanner.h"
 #include "audio.h"
+#include "driver/bk4819.h"
 #include "functions.h"
 #include "helper/battery.h"
 #include "misc.h"
 #include "settings.h"
+#include "sram-text.h"
 
 #include "driver/backlight.h"
 #include "bsp/dp32g030/gpio.h"
@@ -42,12 +44,12 @@
                 flag = true;             \
     } while (0)
 
-static volatile uint32_t gGlobalSysTickCounter;
+volatile uint32_t gGlobalSysTickCounter;
 
 void SystickHandler(void);
 
 // we come here every 10ms
-void SystickHandler(void)
+SRAM_TEXT void SystickHandler(void)
 {
     gGlobalSysTickCounter++;
     
@@ -65,8 +67,15 @@ void SystickHandler(void)
         
         DECREMENT_AND_TRIGGER(gTxTimerCountdown_500ms, gTxTimeoutReached);
         DECREMENT(gSerialConfigCountDown_500ms);
+
+        if (gPowerSaveQuiet_500ms < UINT16_MAX)
+            gPowerSaveQuiet_500ms++;
     }
 
+    gFunctionTime_10ms[gCurrentFunction]++;
+    if (gCurrentFunction == FUNCTION_POWER_SAVE && !gRxIdleMode)
+        gPowerSaveAwake_10ms++;
+
     if ((gGlobalSysTickCounter & 3) == 0)
         gNextTimeslice40ms = true;
 
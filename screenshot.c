@@ -18,6 +18,10 @@
 #include "driver/st7565.h"
 #include "screenshot.h"
 #include "misc.h"
+#ifdef ENABLE_EXTRA_UART_CMD
+    #include "telemetry.h"
+#endif
+#include "trace.h"
 
 void getScreenShot(bool force)
 {
@@ -109,6 +113,14 @@ void getScreenShot(bool force)
     if (deltaLen == 0)
         return; // No update needed
 
+    // finish any streamed frame first, the host reads one frame at a time
+#ifdef ENABLE_REG_TRACE
+    TRACE_StreamEndFrame();
+#endif
+#ifdef ENABLE_EXTRA_UART_CMD
+    TELEMETRY_EndFrame();
+#endif
+
     // Send the delta frame over UART
     uint8_t header[5] = {
         0xAA, 0x55, 0x02,
@@ -42,6 +42,10 @@ static const uint32_t gDefaultFrequencyTable[] =
 #endif
 
 EEPROM_Config_t gEeprom = { 0 };
+uint16_t        gSettingsDirty;
+
+static SETTINGS_Calibration_t gCalibration;
+static bool                   gCalibrationValid;
 
 void SETTINGS_InitEEPROM(void)
 {
@@ -301,7 +305,7 @@ void SETTINGS_InitEEPROM(void)
 
     //gSetting_TX_EN             = (Data[7] & (1u << 0)) ? true : false;
     gSetting_live_DTMF_decoder = !!(Data[7] & (1u << 1));
-    gSetting_battery_text      = (((Data[7] >> 2) & 3u) <= 2) ? (Data[7] >> 2) & 3 : 2;
+    gSetting_battery_text      = (Data[7] >> 2) & 3u;
     #ifdef ENABLE_AUDIO_BAR
         gSetting_mic_bar       = !!(Data[7] & (1u << 4));
     #endif
@@ -401,10 +405,30 @@ void SETTINGS_InitEEPROM(void)
 #endif
 }
 
+const SETTINGS_Calibration_t *SETTINGS_GetCalibration(void)
+{
+    if (!gCalibrationValid) {
+        EEPROM_ReadBuffer(0x1E00, gCalibration.squelch, sizeof(gCalibration.squelch));
+        for (unsigned int band = 0; band < BAND_N_ELEM; band++)
+            EEPROM_ReadBuffer(0x1ED0 + (band * 16), gCalibration.txp[band], sizeof(gCalibration.txp[band]));
+        gCalibrationValid = true;
+    }
+
+    return &gCalibration;
+}
+
+void SETTINGS_InvalidateCalibration(void)
+{
+    gCalibrationValid = false;
+}
+
 void SETTINGS_LoadCalibration(void)
 {
 //  uint8_t Mic;
 
+    SETTINGS_InvalidateCalibration();
+    SETTINGS_GetCalibration();
+
     EEPROM_ReadBuffer(0x1EC0, gEEPROM_RSSI_CALIB[3], 8);
     memcpy(gEEPROM_RSSI_CALIB[4], gEEPROM_RSSI_CALIB[3], 8);
     memcpy(gEEPROM_RSSI_CALIB[5], gEEPROM_RSSI_CALIB[3], 8);
@@ -601,6 +625,11 @@ void SETTINGS_SaveVfoIndices(void)
 }
 
 void SETTINGS_SaveSettings(void)
+{
+    SETTINGS_SaveSettingsBlocks(SETTINGS_BLOCKS_ALL);
+}
+
+void SETTINGS_SaveSettingsBlocks(const uint16_t blocks)
 {
     uint8_t  State[8];
     uint8_t tmp = 0;
@@ -609,232 +638,258 @@ void SETTINGS_SaveSettings(void)
         uint32_t Password[2];
     #endif
 
-    State[0] = gEeprom.CHAN_1_CALL;
-    State[1] = gEeprom.SQUELCH_LEVEL;
-    State[2] = gEeprom.TX_TIMEOUT_TIMER;
-    #ifdef ENABLE_NOAA
-        State[3] = gEeprom.NOAA_AUTO_SCAN;
-    #else
-        State[3] = false;
-    #endif
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E70)) {
+        State[0] = gEeprom.CHAN_1_CALL;
+        State[1] = gEeprom.SQUELCH_LEVEL;
+        State[2] = gEeprom.TX_TIMEOUT_TIMER;
+        #ifdef ENABLE_NOAA
+            State[3] = gEeprom.NOAA_AUTO_SCAN;
+        #else
+            State[3] = false;
+        #endif
 
-    #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
-        State[4] = (gEeprom.KEY_LOCK ? 0x01 : 0) | (gEeprom.MENU_LOCK ? 0x02 :0) | ((gEeprom.SET_KEY & 0x0F) << 2);
-    #else
-        State[4] = gEeprom.KEY_LOCK;
-    #endif
+        #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
+            State[4] = (gEeprom.KEY_LOCK ? 0x01 : 0) | (gEeprom.MENU_LOCK ? 0x02 :0) | ((gEeprom.SET_KEY & 0x0F) << 2);
+        #else
+            State[4] = gEeprom.KEY_LOCK;
+        #endif
 
-    #ifdef ENABLE_VOX
-        State[5] = gEeprom.VOX_SWITCH;
-        State[6] = gEeprom.VOX_LEVEL;
-    #else
-        State[5] = false;
-        State[6] = 0;
-    #endif
-    State[7] = gEeprom.MIC_SENSITIVITY;
-    EEPROM_WriteBuffer(0x0E70, State);
+        #ifdef ENABLE_VOX
+            State[5] = gEeprom.VOX_SWITCH;
+            State[6] = gEeprom.VOX_LEVEL;
+        #else
+            State[5] = false;
+            State[6] = 0;
+        #endif
+        State[7] = gEeprom.MIC_SENSITIVITY;
+        EEPROM_WriteBuffer(0x0E70, State);
+    }
 
-    State[0] = (gEeprom.BACKLIGHT_MIN << 4) + gEeprom.BACKLIGHT_MAX;
-    State[1] = gEeprom.CHANNEL_DISPLAY_MODE;
-    State[2] = gEeprom.CROSS_BAND_RX_TX;
-    State[3] = gEeprom.BATTERY_SAVE;
-    State[4] = gEeprom.DUAL_WATCH;
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E78)) {
+        State[0] = (gEeprom.BACKLIGHT_MIN << 4) + gEeprom.BACKLIGHT_MAX;
+        State[1] = gEeprom.CHANNEL_DISPLAY_MODE;
+        State[2] = gEeprom.CROSS_BAND_RX_TX;
+        State[3] = gEeprom.BATTERY_SAVE;
+        State[4] = gEeprom.DUAL_WATCH;
 
-    #ifdef ENABLE_FEAT_F4HWN
-        if(!gSaveRxMode)
-        {
-            State[2] = gCB;
-            State[4] = gDW;
-        }
-        if(gBackLight)
-        {
-            State[5] = gBacklightTimeOriginal;
-        }
-        else
-        {
+        #ifdef ENABLE_FEAT_F4HWN
+            if(!gSaveRxMode)
+            {
+                State[2] = gCB;
+                State[4] = gDW;
+            }
+            if(gBackLight)
+            {
+                State[5] = gBacklightTimeOriginal;
+            }
+            else
+            {
+                State[5] = gEeprom.BACKLIGHT_TIME;
+            }
+        #else
             State[5] = gEeprom.BACKLIGHT_TIME;
-        }
-    #else
-        State[5] = gEeprom.BACKLIGHT_TIME;
-    #endif
+        #endif
 
-    #ifdef ENABLE_FEAT_F4HWN_NARROWER
-        State[6] = (gEeprom.TAIL_TONE_ELIMINATION & 0x01) | ((gSetting_set_nfm & 0x03) << 1);
-    #else
-        State[6] = gEeprom.TAIL_TONE_ELIMINATION;
-    #endif
+        #ifdef ENABLE_FEAT_F4HWN_NARROWER
+            State[6] = (gEeprom.TAIL_TONE_ELIMINATION & 0x01) | ((gSetting_set_nfm & 0x03) << 1);
+        #else
+            State[6] = gEeprom.TAIL_TONE_ELIMINATION;
+        #endif
 
-    #ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
-        State[7] = (gEeprom.VFO_OPEN & 0x01) | ((gEeprom.CURRENT_STATE & 0x07) << 1) | ((gEeprom.SCAN_LIST_DEFAULT & 0x07) << 4);
-    #else
-        State[7] = gEeprom.VFO_OPEN;
-    #endif
-    EEPROM_WriteBuffer(0x0E78, State);
-
-    State[0] = gEeprom.BEEP_CONTROL;
-    State[0] |= gEeprom.KEY_M_LONG_PRESS_ACTION << 1;
-    State[1] = gEeprom.KEY_1_SHORT_PRESS_ACTION;
-    State[2] = gEeprom.KEY_1_LONG_PRESS_ACTION;
-    State[3] = gEeprom.KEY_2_SHORT_PRESS_ACTION;
-    State[4] = gEeprom.KEY_2_LONG_PRESS_ACTION;
-    State[5] = gEeprom.SCAN_RESUME_MODE;
-    State[6] = gEeprom.AUTO_KEYPAD_LOCK;
-    State[7] = gEeprom.POWER_ON_DISPLAY_MODE;
-    EEPROM_WriteBuffer(0x0E90, State);
+        #ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
+            State[7] = (gEeprom.VFO_OPEN & 0x01) | ((gEeprom.CURRENT_STATE & 0x07) << 1) | ((gEeprom.SCAN_LIST_DEFAULT & 0x07) << 4);
+        #else
+            State[7] = gEeprom.VFO_OPEN;
+        #endif
+        EEPROM_WriteBuffer(0x0E78, State);
+    }
+
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E90)) {
+        State[0] = gEeprom.BEEP_CONTROL;
+        State[0] |= gEeprom.KEY_M_LONG_PRESS_ACTION << 1;
+        State[1] = gEeprom.KEY_1_SHORT_PRESS_ACTION;
+        State[2] = gEeprom.KEY_1_LONG_PRESS_ACTION;
+        State[3] = gEeprom.KEY_2_SHORT_PRESS_ACTION;
+        State[4] = gEeprom.KEY_2_LONG_PRESS_ACTION;
+        State[5] = gEeprom.SCAN_RESUME_MODE;
+        State[6] = gEeprom.AUTO_KEYPAD_LOCK;
+        State[7] = gEeprom.POWER_ON_DISPLAY_MODE;
+        EEPROM_WriteBuffer(0x0E90, State);
+    }
 
     #ifdef ENABLE_PWRON_PASSWORD
-        memset(Password, 0xFF, sizeof(Password));
-        Password[0] = gEeprom.POWER_ON_PASSWORD;
-        EEPROM_WriteBuffer(0x0E98, Password);
+        if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0E98)) {
+            memset(Password, 0xFF, sizeof(Password));
+            Password[0] = gEeprom.POWER_ON_PASSWORD;
+            EEPROM_WriteBuffer(0x0E98, Password);
+        }
     #endif
 
-    memset(State, 0xFF, sizeof(State));
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0EA0)) {
+        memset(State, 0xFF, sizeof(State));
 #ifdef ENABLE_VOICE
-    State[0] = gEeprom.VOICE_PROMPT;
+        State[0] = gEeprom.VOICE_PROMPT;
 #endif
 #ifdef ENABLE_RSSI_BAR
-    State[1] = gEeprom.S0_LEVEL;
-    State[2] = gEeprom.S9_LEVEL;
+        State[1] = gEeprom.S0_LEVEL;
+        State[2] = gEeprom.S9_LEVEL;
 #endif
-    EEPROM_WriteBuffer(0x0EA0, State);
+        EEPROM_WriteBuffer(0x0EA0, State);
+    }
 
 
-    #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
-        State[0] = gEeprom.ALARM_MODE;
-    #else
-        State[0] = false;
-    #endif
-    State[1] = gEeprom.ROGER;
-    State[2] = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
-    State[3] = gEeprom.TX_VFO;
-    State[4] = gEeprom.BATTERY_TYPE;
-    EEPROM_WriteBuffer(0x0EA8, State);
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0EA8)) {
+        memset(State, 0xFF, sizeof(State));
+        #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
+            State[0] = gEeprom.ALARM_MODE;
+        #else
+            State[0] = false;
+        #endif
+        State[1] = gEeprom.ROGER;
+        State[2] = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
+        State[3] = gEeprom.TX_VFO;
+        State[4] = gEeprom.BATTERY_TYPE;
+        EEPROM_WriteBuffer(0x0EA8, State);
+    }
 
-    State[0] = gEeprom.DTMF_SIDE_TONE;
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0ED0)) {
+        memset(State, 0xFF, sizeof(State));
+        State[0] = gEeprom.DTMF_SIDE_TONE;
 #ifdef ENABLE_DTMF_CALLING
-    State[1] = gEeprom.DTMF_SEPARATE_CODE;
-    State[2] = gEeprom.DTMF_GROUP_CALL_CODE;
-    State[3] = gEeprom.DTMF_DECODE_RESPONSE;
-    State[4] = gEeprom.DTMF_auto_reset_time;
+        State[1] = gEeprom.DTMF_SEPARATE_CODE;
+        State[2] = gEeprom.DTMF_GROUP_CALL_CODE;
+        State[3] = gEeprom.DTMF_DECODE_RESPONSE;
+        State[4] = gEeprom.DTMF_auto_reset_time;
 #endif
-    State[5] = gEeprom.DTMF_PRELOAD_TIME / 10U;
-    State[6] = gEeprom.DTMF_FIRST_CODE_PERSIST_TIME / 10U;
-    State[7] = gEeprom.DTMF_HASH_CODE_PERSIST_TIME / 10U;
-    EEPROM_WriteBuffer(0x0ED0, State);
-
-    memset(State, 0xFF, sizeof(State));
-    State[0] = gEeprom.DTMF_CODE_PERSIST_TIME / 10U;
-    State[1] = gEeprom.DTMF_CODE_INTERVAL_TIME / 10U;
+        State[5] = gEeprom.DTMF_PRELOAD_TIME / 10U;
+        State[6] = gEeprom.DTMF_FIRST_CODE_PERSIST_TIME / 10U;
+        State[7] = gEeprom.DTMF_HASH_CODE_PERSIST_TIME / 10U;
+        EEPROM_WriteBuffer(0x0ED0, State);
+    }
+
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0ED8)) {
+        memset(State, 0xFF, sizeof(State));
+        State[0] = gEeprom.DTMF_CODE_PERSIST_TIME / 10U;
+        State[1] = gEeprom.DTMF_CODE_INTERVAL_TIME / 10U;
 #ifdef ENABLE_DTMF_CALLING
-    State[2] = gEeprom.PERMIT_REMOTE_KILL;
+        State[2] = gEeprom.PERMIT_REMOTE_KILL;
 #endif
-    EEPROM_WriteBuffer(0x0ED8, State);
-
-    State[0] = gEeprom.SCAN_LIST_DEFAULT;
-
-    tmp = 0;
-
-    if (gEeprom.SCAN_LIST_ENABLED[0] == 1)
-        tmp = tmp | (1 << 0);
-    if (gEeprom.SCAN_LIST_ENABLED[1] == 1)
-        tmp = tmp | (1 << 1);
-    if (gEeprom.SCAN_LIST_ENABLED[2] == 1)
-        tmp = tmp | (1 << 2);
-
-    State[1] = tmp;
-    State[2] = gEeprom.SCANLIST_PRIORITY_CH1[0];
-    State[3] = gEeprom.SCANLIST_PRIORITY_CH2[0];
-    State[4] = gEeprom.SCANLIST_PRIORITY_CH1[1];
-    State[5] = gEeprom.SCANLIST_PRIORITY_CH2[1];
-    State[6] = gEeprom.SCANLIST_PRIORITY_CH1[2];
-    State[7] = gEeprom.SCANLIST_PRIORITY_CH2[2];
-    EEPROM_WriteBuffer(0x0F18, State);
-
-    memset(State, 0xFF, sizeof(State));
-    State[0]  = gSetting_F_LOCK;
+        EEPROM_WriteBuffer(0x0ED8, State);
+    }
+
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0F18)) {
+        State[0] = gEeprom.SCAN_LIST_DEFAULT;
+
+        tmp = 0;
+
+        if (gEeprom.SCAN_LIST_ENABLED[0] == 1)
+            tmp = tmp | (1 << 0);
+        if (gEeprom.SCAN_LIST_ENABLED[1] == 1)
+            tmp = tmp | (1 << 1);
+        if (gEeprom.SCAN_LIST_ENABLED[2] == 1)
+            tmp = tmp | (1 << 2);
+
+        State[1] = tmp;
+        State[2] = gEeprom.SCANLIST_PRIORITY_CH1[0];
+        State[3] = gEeprom.SCANLIST_PRIORITY_CH2[0];
+        State[4] = gEeprom.SCANLIST_PRIORITY_CH1[1];
+        State[5] = gEeprom.SCANLIST_PRIORITY_CH2[1];
+        State[6] = gEeprom.SCANLIST_PRIORITY_CH1[2];
+        State[7] = gEeprom.SCANLIST_PRIORITY_CH2[2];
+        EEPROM_WriteBuffer(0x0F18, State);
+    }
+
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_0F40)) {
+        memset(State, 0xFF, sizeof(State));
+        State[0]  = gSetting_F_LOCK;
 #ifndef ENABLE_FEAT_F4HWN
-    State[1]  = gSetting_350TX;
+        State[1]  = gSetting_350TX;
 #endif
 #ifdef ENABLE_DTMF_CALLING
-    State[2]  = gSetting_KILLED;
+        State[2]  = gSetting_KILLED;
 #endif
 #ifndef ENABLE_FEAT_F4HWN
-    State[3]  = gSetting_200TX;
-    State[4]  = gSetting_500TX;
+        State[3]  = gSetting_200TX;
+        State[4]  = gSetting_500TX;
 #endif
-    State[5]  = gSetting_350EN;
+        State[5]  = gSetting_350EN;
 #ifdef ENABLE_FEAT_F4HWN
-    State[6]  = false;
+        State[6]  = false;
 #else
-    State[6]  = gSetting_ScrambleEnable;
+        State[6]  = gSetting_ScrambleEnable;
 #endif
 
-    //if (!gSetting_TX_EN)             State[7] &= ~(1u << 0);
-    if (!gSetting_live_DTMF_decoder) State[7] &= ~(1u << 1);
-    State[7] = (State[7] & ~(3u << 2)) | ((gSetting_battery_text & 3u) << 2);
-    #ifdef ENABLE_AUDIO_BAR
-        if (!gSetting_mic_bar)           State[7] &= ~(1u << 4);
-    #endif
-    #ifndef ENABLE_FEAT_F4HWN
-        #ifdef ENABLE_AM_FIX
-            if (!gSetting_AM_fix)            State[7] &= ~(1u << 5);
+        //if (!gSetting_TX_EN)             State[7] &= ~(1u << 0);
+        if (!gSetting_live_DTMF_decoder) State[7] &= ~(1u << 1);
+        State[7] = (State[7] & ~(3u << 2)) | ((gSetting_battery_text & 3u) << 2);
+        #ifdef ENABLE_AUDIO_BAR
+            if (!gSetting_mic_bar)           State[7] &= ~(1u << 4);
         #endif
-    #endif
-    State[7] = (State[7] & ~(3u << 6)) | ((gSetting_backlight_on_tx_rx & 3u) << 6);
+        #ifndef ENABLE_FEAT_F4HWN
+            #ifdef ENABLE_AM_FIX
+                if (!gSetting_AM_fix)            State[7] &= ~(1u << 5);
+            #endif
+        #endif
+        State[7] = (State[7] & ~(3u << 6)) | ((gSetting_backlight_on_tx_rx & 3u) << 6);
 
-    EEPROM_WriteBuffer(0x0F40, State);
+        EEPROM_WriteBuffer(0x0F40, State);
+    }
 
 #ifdef ENABLE_FEAT_F4HWN
-    EEPROM_ReadBuffer(0x1FF0, State, sizeof(State));
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_1FF0)) {
+        EEPROM_ReadBuffer(0x1FF0, State, sizeof(State));
 
-    //memset(State, 0xFF, sizeof(State));
+        //memset(State, 0xFF, sizeof(State));
 
-    /*
-    tmp = 0;
+        /*
+        tmp = 0;
 
-    if(gSetting_set_tmr == 1)
-        tmp = tmp | (1 << 0);
+        if(gSetting_set_tmr == 1)
+            tmp = tmp | (1 << 0);
 
-    State[4] = tmp;
+        State[4] = tmp;
 
-    tmp = 0;
+        tmp = 0;
 
-    if(gSetting_set_inv == 1)
-        tmp = tmp | (1 << 0);
-    if (gSetting_set_lck == 1)
-        tmp = tmp | (1 << 1);
-    if (gSetting_set_met == 1)
-        tmp = tmp | (1 << 2);
-    if (gSetting_set_gui == 1)
-        tmp = tmp | (1 << 3);
-    */
+        if(gSetting_set_inv == 1)
+            tmp = tmp | (1 << 0);
+        if (gSetting_set_lck == 1)
+            tmp = tmp | (1 << 1);
+        if (gSetting_set_met == 1)
+            tmp = tmp | (1 << 2);
+        if (gSetting_set_gui == 1)
+            tmp = tmp | (1 << 3);
+        */
 
 #ifdef ENABLE_FEAT_F4HWN_SLEEP 
-    State[4] = (gSetting_set_off << 1) | (gSetting_set_tmr & 0x01);
+        State[4] = (gSetting_set_off << 1) | (gSetting_set_tmr & 0x01);
 #else
-    State[4] = gSetting_set_tmr ? (1 << 0) : 0;
+        State[4] = gSetting_set_tmr ? (1 << 0) : 0;
 #endif
 
-    tmp =   (gSetting_set_inv << 0) |
-            (gSetting_set_lck << 1) |
-            (gSetting_set_met << 2) |
-            (gSetting_set_gui << 3);
+        tmp =   (gSetting_set_inv << 0) |
+                (gSetting_set_lck << 1) |
+                (gSetting_set_met << 2) |
+                (gSetting_set_gui << 3);
 
-    State[5] = ((tmp << 4) | (gSetting_set_ctr & 0x0F));
-    State[6] = ((gSetting_set_tot << 4) | (gSetting_set_eot & 0x0F));
-    State[7] = ((gSetting_set_pwr << 4) | (gSetting_set_ptt & 0x0F));
+        State[5] = ((tmp << 4) | (gSetting_set_ctr & 0x0F));
+        State[6] = ((gSetting_set_tot << 4) | (gSetting_set_eot & 0x0F));
+        State[7] = ((gSetting_set_pwr << 4) | (gSetting_set_ptt & 0x0F));
 
-    gEeprom.KEY_LOCK_PTT = gSetting_set_lck;
+        gEeprom.KEY_LOCK_PTT = gSetting_set_lck;
 
-    EEPROM_WriteBuffer(0x1FF0, State);
+        EEPROM_WriteBuffer(0x1FF0, State);
+    }
 #endif
 
 #ifdef ENABLE_FEAT_F4HWN_VOL
-    SETTINGS_WriteCurrentVol();
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_VOL))
+        SETTINGS_WriteCurrentVol();
 #endif
 
 #ifdef ENABLE_CW
-    CW_SaveSettings();
+    if (blocks & SETTINGS_BLOCK_BIT(SETTINGS_BLOCK_CW))
+        CW_SaveSettings();
 #endif
 }
 
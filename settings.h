@@ -127,6 +127,7 @@ enum ACTION_OPT_t {
     ACTION_OPT_REGA_ALARM,
     ACTION_OPT_REGA_TEST,
 #endif
+    ACTION_OPT_FM_SCAN,
     ACTION_OPT_LEN
 };
 
@@ -306,8 +307,44 @@ typedef struct {
 
 extern EEPROM_Config_t gEeprom;
 
+// RAM copy of the squelch and TX power calibration tables (EEPROM 1E00..1F3F),
+// read on every channel/frequency change so they are not fetched over I2C each time
+#define CALIBRATION_EEPROM_START 0x1E00
+#define CALIBRATION_EEPROM_END   0x1F40
+
+typedef struct {
+    uint8_t squelch[2][6][16]; // [UHF 1E00, VHF 1E60][open rssi, close rssi, open noise, close noise, close glitch, open glitch][level]
+    uint8_t txp[BAND_N_ELEM][3][3]; // 1ED0 + band * 16, [low, mid, high][3 points]
+} __attribute__((packed)) SETTINGS_Calibration_t;
+
+// the eeprom blocks SETTINGS_SaveSettings() writes, a changed setting marks
+// its block in gSettingsDirty so only that block gets rewritten
+typedef enum {
+    SETTINGS_BLOCK_NONE = 0,
+    SETTINGS_BLOCK_0E70,
+    SETTINGS_BLOCK_0E78,
+    SETTINGS_BLOCK_0E90,
+    SETTINGS_BLOCK_0E98,
+    SETTINGS_BLOCK_0EA0,
+    SETTINGS_BLOCK_0EA8,
+    SETTINGS_BLOCK_0ED0,
+    SETTINGS_BLOCK_0ED8,
+    SETTINGS_BLOCK_0F18,
+    SETTINGS_BLOCK_0F40,
+    SETTINGS_BLOCK_1FF0,
+    SETTINGS_BLOCK_VOL,
+    SETTINGS_BLOCK_CW,
+} SETTINGS_Block_t;
+
+#define SETTINGS_BLOCK_BIT(block) (1u << (block))
+#define SETTINGS_BLOCKS_ALL       0xFFFFu
+
+extern uint16_t gSettingsDirty;
+
 void     SETTINGS_InitEEPROM(void);
 void     SETTINGS_LoadCalibration(void);
+const SETTINGS_Calibration_t *SETTINGS_GetCalibration(void);
+void     SETTINGS_InvalidateCalibration(void);
 uint32_t SETTINGS_FetchChannelFrequency(const int channel);
 void     SETTINGS_FetchChannelName(char *s, const int channel);
 void     SETTINGS_FactoryReset(bool bIsAll);
@@ -316,6 +353,7 @@ void     SETTINGS_FactoryReset(bool bIsAll);
 #endif
 void SETTINGS_SaveVfoIndices(void);
 void SETTINGS_SaveSettings(void);
+void SETTINGS_SaveSettingsBlocks(const uint16_t blocks);
 void SETTINGS_SaveChannelName(uint8_t channel, const char * name);
 void SETTINGS_SaveChannel(uint8_t Channel, uint8_t VFO, const VFO_Info_t *pVFO, uint8_t Mode);
 void SETTINGS_SaveBatteryCalibration(const uint16_t * batteryCalibration);
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+
+# Flash budget report
+#
+# Builds the firmware with the current Makefile options, then once more with
+# each ENABLE_* option flipped, and prints what every option costs in flash
+# and RAM together with the biggest objects and symbols of the baseline image.
+# Exits non zero when the baseline image does not fit the flash budget.
+#
+#   make size-report                          every feature option
+#   make size-report SIZE_FLAGS="ENABLE_CW ENABLE_NOAA"
+#   make size-report FLASH_BUDGET=59392       keep 1K spare
+#
+# The tree is rebuilt in place, run "make clean" before building for real.
+
+import argparse
+import collections
+import os
+import re
+import subprocess
+import sys
+
+# options that pick the toolchain or debug aids rather than a feature
+NOT_FEATURES = {
+    'ENABLE_CLANG', 'ENABLE_SWD', 'ENABLE_OVERLAY', 'ENABLE_LTO', 'ENABLE_SRAM_TEXT',
+    'ENABLE_AM_FIX_SHOW_DATA', 'ENABLE_AGC_SHOW_DATA', 'ENABLE_UART_RW_BK_REGS', 'ENABLE_TRACE', 'ENABLE_REG_TRACE',
+}
+
+TARGET = 'size-report-fw'
+
+def run(cmd, quiet=True):
+    return subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT if quiet else None,
+                          universal_newlines=True)
+
+def makefile_options(path):
+    names = []
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'^(ENABLE_\w+)\s*\?=', line)
+            if m and m.group(1) not in NOT_FEATURES:
+                names.append(m.group(1))
+    return names
+
+def current_values(make, names):
+    # ask make, so options given on its command line are taken into account
+    out = run([make, '-s', '--no-print-directory'] + ['print-' + n for n in names]).stdout
+    values = {}
+    for line in out.splitlines():
+        name, _, value = line.partition('=')
+        if name in names:
+            values[name] = value.strip()
+    return values
+
+def build(args, overrides):
+    run([args.make, '-s', 'clean', 'TARGET=' + TARGET])
+    cmd = [args.make, '-s', '-j%d' % args.jobs, 'TARGET=' + TARGET, 'SIZE_REPORT_MAP=1']
+    cmd += ['%s=%s' % kv for kv in overrides.items()]
+    if run(cmd).returncode != 0 or not os.path.exists(TARGET):
+        return None
+
+    # berkeley format: text data bss dec hex filename
+    text, data, bss = map(int, run([args.size, TARGET]).stdout.splitlines()[1].split()[:3])
+    return {'flash': text + data, 'ram': data + bss}
+
+def parse_map(path):
+    # input sections of the flash and ram images, summed per object
+    sizes = collections.Counter()
+    section = None
+    pending = None
+    with open(path) as f:
+        lines = f.read().split('Linker script and memory map', 1)[-1].splitlines()
+
+    for line in lines:
+        m = re.match(r'^(\.\w+)\b', line)
+        if m:
+            section = m.group(1)
+            continue
+        if section not in ('.text', '.data', '.bss'):
+            continue
+
+        m = re.match(r'^ (\.\S+|COMMON)(?:\s+0x[0-9a-f]+\s+0x([0-9a-f]+)\s+(\S.*))?$', line)
+        if m:
+            if m.group(2) is None:
+                pending = True   # long section name, address and size on the next line
+                continue
+            size, obj = int(m.group(2), 16), m.group(3)
+        elif pending:
+            pending = None
+            m = re.match(r'^\s+0x[0-9a-f]+\s+0x([0-9a-f]+)\s+(\S.*)$', line)
+            if not m:
+                continue
+            size, obj = int(m.group(1), 16), m.group(2)
+        else:
+            continue
+
+        obj = re.sub(r'^.*/lib(\w+)\.a\(.*\)$', r'lib\1', obj)
+        sizes[(obj, 'ram' if section == '.bss' else 'flash')] += size
+    return sizes
+
+def top_symbols(args, count):
+    out = run([args.nm, '--print-size', '--size-sort', '--reverse-sort', TARGET]).stdout
+    symbols = []
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4:
+            symbols.append((int(fields[1], 16), fields[2], fields[3]))
+    return symbols[:count]
+
+def main():
+    parser = argparse.ArgumentParser(description='Per feature flash/RAM cost of the firmware')
+    parser.add_argument('--budget', type=int, default=0, help='flash budget in bytes, 0 for none')
+    parser.add_argument('--flags', nargs='*', default=None, help='ENABLE_* options to cost, all by default')
+    parser.add_argument('--top', type=int, default=20, help='number of objects and symbols to list')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1)
+    parser.add_argument('--make', default=os.environ.get('MAKE', 'make'))
+    parser.add_argument('--size', default='arm-none-eabi-size')
+    parser.add_argument('--nm', default='arm-none-eabi-nm')
+    args = parser.parse_args()
+
+    names  = args.flags if args.flags else makefile_options('Makefile')
+    values = current_values(args.make, names)
+
+    baseline = build(args, {})
+    if baseline is None:
+        sys.exit('baseline build failed')
+
+    symbols = top_symbols(args, args.top)
+
+    # LTO merges every object into one, the per object split needs a plain build
+    objects = None
+    if build(args, {'ENABLE_LTO': '0'}) is not None and os.path.exists(TARGET + '.map'):
+        objects = parse_map(TARGET + '.map')
+
+    costs = []
+    for name in names:
+        value   = values.get(name, '0')
+        enabled = value not in ('', '0')
+        result  = build(args, {name: '0' if enabled else '1'})
+        if result is None:
+            costs.append((name, value, None, None))
+        elif enabled:
+            costs.append((name, value, baseline['flash'] - result['flash'], baseline['ram'] - result['ram']))
+        else:
+            costs.append((name, value, result['flash'] - baseline['flash'], result['ram'] - baseline['ram']))
+
+    run([args.make, '-s', 'clean', 'TARGET=' + TARGET])
+
+    print('baseline: %u bytes flash, %u bytes RAM' % (baseline['flash'], baseline['ram']))
+    if args.budget:
+        print('budget:   %u bytes flash, %d bytes spare' % (args.budget, args.budget - baseline['flash']))
+
+    print('\n%-34s %5s %8s %8s' % ('option', 'now', 'flash', 'ram'))
+    for name, value, flash, ram in sorted(costs, key=lambda c: -(c[2] or 0)):
+        if flash is None:
+            print('%-34s %5s %17s' % (name, value, 'does not build'))
+        else:
+            print('%-34s %5s %+8d %+8d' % (name, value, flash, ram))
+    print('(flash/ram: what the option costs when on, measured by flipping it alone)')
+
+    if objects:
+        print('\n%-34s %8s %8s' % ('object (no LTO)', 'flash', 'ram'))
+        objs = sorted({obj for obj, _ in objects}, key=lambda o: -objects[(o, 'flash')])
+        for obj in objs[:args.top]:
+            print('%-34s %8u %8u' % (obj, objects[(obj, 'flash')], objects[(obj, 'ram')]))
+
+    print('\n%-34s %8s' % ('symbol', 'bytes'))
+    for size, kind, name in symbols:
+        print('%-34s %8u  %s' % (name, size, kind))
+
+    if args.budget and baseline['flash'] > args.budget:
+        sys.exit('\nflash budget exceeded by %u bytes' % (baseline['flash'] - args.budget))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,38 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef SRAM_TEXT_H
+#define SRAM_TEXT_H
+
+// SRAM_TEXT runs a function from RAM, free of the flash wait states
+//
+// the function goes to .sramtext, which firmware.ld links into the .data
+// image, so DATA_Init() copies it to RAM along with the initialised data.
+// It costs its size in RAM as well as in flash, keep it for small hot code.
+// noinline and noclone stop LTO from inlining the body into a flash caller
+// or emitting a specialised copy of it outside the section
+
+#ifdef ENABLE_SRAM_TEXT
+    #ifdef __clang__
+        #define SRAM_TEXT __attribute__((section(".sramtext"), noinline))
+    #else
+        #define SRAM_TEXT __attribute__((section(".sramtext"), noinline, noclone))
+    #endif
+#else
+    #define SRAM_TEXT
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+
+# Telemetry logger
+#
+# Subscribes to the telemetry stream of a radio built with
+# ENABLE_EXTRA_UART_CMD=1 (UART command 0x0539) and writes one CSV row per
+# sample until Ctrl-C. Each row carries the host wall clock so it can be
+# joined with a GPS track afterwards.
+#
+#   ./telemetry-log.py /dev/ttyUSB0 drive.csv
+#   ./telemetry-log.py /dev/ttyUSB0 drive.csv --period 50
+
+import argparse
+import csv
+import struct
+import sys
+import time
+
+BAUDRATE = 38400
+TIMEOUT  = 1.0
+
+OBFUSCATION = [0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80]
+
+SAMPLE = struct.Struct('<IHHBBHbbBxHH')   # TELEMETRY_Sample_t
+
+FUNCTIONS = ['FOREGROUND', 'TRANSMIT', 'MONITOR', 'INCOMING', 'RECEIVE', 'POWER_SAVE', 'BAND_SCOPE']
+
+COLUMNS = ['host_time', 'radio_time_s', 'seq', 'rssi_dbm', 'rssi_raw', 'ex_noise', 'glitch',
+           'af_amplitude', 'agc_index', 'rx_gain_db', 'function', 'battery_v', 'current']
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+def crc16_xmodem(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+    return crc & 0xFFFF
+
+def send_command(port, data):
+    body = data + struct.pack('<H', crc16_xmodem(data))
+    port.write(struct.pack('>HBB', 0xABCD, len(data), 0) + obfuscate(body) + struct.pack('>H', 0xDCBA))
+
+def read_frame(port):
+    # 0xAA 0x55 type size(BE16) payload 0x0A, screenshots share the framing
+    if port.read(1) != b'\xAA' or port.read(1) != b'\x55':
+        return None
+    header = port.read(3)
+    if len(header) != 3:
+        return None
+    size    = header[1] << 8 | header[2]
+    payload = port.read(size)
+    if port.read(1) != b'\x0A' or len(payload) != size or header[0] != 0x04 or size < SAMPLE.size:
+        return None
+    return SAMPLE.unpack_from(payload)
+
+def log(port, path, period):
+    # session hello, the reply is not needed
+    send_command(port, struct.pack('<HHI', 0x0514, 4, 0x6457396A))
+    time.sleep(0.2)
+    port.reset_input_buffer()
+
+    send_command(port, struct.pack('<HHH2x', 0x0539, 4, period))
+
+    count    = 0
+    dropped  = 0
+    expected = None
+    print('logging to %s every %u ms, Ctrl-C to stop' % (path, period * 10))
+    with open(path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(COLUMNS)
+        try:
+            while True:
+                sample = read_frame(port)
+                if sample is None:
+                    continue
+                t, seq, rssi, noise, glitch, af, agc, gain, function, voltage, current = sample
+                if expected is not None:
+                    dropped += (seq - expected) & 0xFFFF
+                expected = (seq + 1) & 0xFFFF
+                writer.writerow(['%.3f' % time.time(), '%.2f' % (t / 100), seq, '%.1f' % (rssi / 2 - 160),
+                                 rssi, noise, glitch, af, agc, gain,
+                                 FUNCTIONS[function] if function < len(FUNCTIONS) else function,
+                                 '%.2f' % (voltage / 100), current])
+                count += 1
+        except KeyboardInterrupt:
+            pass
+
+    send_command(port, struct.pack('<HHH2x', 0x0539, 4, 0))
+    print('%u samples logged, %u dropped while the UART was busy' % (count, dropped))
+
+def main():
+    parser = argparse.ArgumentParser(description='Log the radio telemetry stream to CSV')
+    parser.add_argument('port', help='serial port of the programming cable')
+    parser.add_argument('csv', help='output file')
+    parser.add_argument('--period', type=int, default=10, help='sample period in 10ms ticks (default 10)')
+    args = parser.parse_args()
+
+    if not 1 <= args.period <= 0xFFFF:
+        parser.error('period out of range')
+
+    import serial
+    with serial.Serial(args.port, BAUDRATE, timeout=TIMEOUT) as port:
+        log(port, args.csv, args.period)
+
+if __name__ == '__main__':
+    sys.exit(main())
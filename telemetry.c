@@ -0,0 +1,96 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "driver/bk4819.h"
+#include "driver/uart.h"
+#include "functions.h"
+#include "helper/battery.h"
+#include "misc.h"
+#include "telemetry.h"
+
+uint16_t gTelemetryPeriod_10ms;
+
+static uint16_t gCountdown_10ms;
+static uint16_t gSeq;
+
+static uint8_t  gFrame[5 + sizeof(TELEMETRY_Sample_t) + 1];
+static uint8_t  gFramePos = sizeof(gFrame);   // all of it sent
+
+void TELEMETRY_Start(uint16_t Period_10ms)
+{
+    TELEMETRY_EndFrame();
+
+    gTelemetryPeriod_10ms = Period_10ms;
+    gCountdown_10ms       = 1;
+    gSeq                  = 0;
+}
+
+void TELEMETRY_TimeSlice10ms(void)
+{
+    if (gTelemetryPeriod_10ms == 0 || --gCountdown_10ms > 0)
+        return;
+
+    gCountdown_10ms = gTelemetryPeriod_10ms;
+
+    if (gFramePos != sizeof(gFrame)) {
+        gSeq++;   // the last one is still going out
+        return;
+    }
+
+    const uint16_t Reg7E = BK4819_ReadRegister(BK4819_REG_7E);
+
+    const TELEMETRY_Sample_t Sample = {
+        .Time_10ms   = gGlobalSysTickCounter,
+        .Seq         = gSeq++,
+        .RSSI        = BK4819_GetRSSI(),
+        .ExNoise     = BK4819_GetExNoiceIndicator(),
+        .Glitch      = BK4819_GetGlitchIndicator(),
+        .AfAmplitude = BK4819_GetVoiceAmplitudeOut(),
+        .AgcIndex    = (int8_t)(((Reg7E >> 12) & 7u) ^ 4u) - 4,   // 3 bit signed
+        .RxGain_dB   = BK4819_GetRxGain_dB(),
+        .Function    = gCurrentFunction,
+        .Voltage     = gBatteryVoltageAverage,
+        .Current     = gBatteryCurrent,
+    };
+
+    gFrame[0] = 0xAA;
+    gFrame[1] = 0x55;
+    gFrame[2] = 0x04;
+    gFrame[3] = 0;
+    gFrame[4] = sizeof(Sample);
+    memcpy(&gFrame[5], &Sample, sizeof(Sample));
+    gFrame[sizeof(gFrame) - 1] = 0x0A;
+    gFramePos = 0;
+
+    TELEMETRY_Send();
+}
+
+void TELEMETRY_Send(void)
+{
+    if (gFramePos != sizeof(gFrame))
+        gFramePos += UART_TrySend(&gFrame[gFramePos], sizeof(gFrame) - gFramePos);
+}
+
+void TELEMETRY_EndFrame(void)
+{
+    if (gFramePos != sizeof(gFrame)) {
+        UART_Send(&gFrame[gFramePos], sizeof(gFrame) - gFramePos);
+        gFramePos = sizeof(gFrame);
+    }
+}
@@ -0,0 +1,48 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+// receiver telemetry pushed over the UART at a set rate (command 0x0539,
+// see telemetry-log.py), a sample is dropped rather than wait for the UART
+
+// 0xAA 0x55 0x04, size BE16, TELEMETRY_Sample_t, 0x0A
+typedef struct {
+    uint32_t Time_10ms;
+    uint16_t Seq;           // samples taken, a gap is samples dropped
+    uint16_t RSSI;          // REG_67, dBm = RSSI / 2 - 160
+    uint8_t  ExNoise;
+    uint8_t  Glitch;
+    uint16_t AfAmplitude;   // REG_64
+    int8_t   AgcIndex;      // REG_7E, -1 to 3
+    int8_t   RxGain_dB;
+    uint8_t  Function;
+    uint8_t  Padding;
+    uint16_t Voltage;       // 10mV
+    uint16_t Current;
+} TELEMETRY_Sample_t;
+
+extern uint16_t gTelemetryPeriod_10ms;   // 0 when off
+
+void TELEMETRY_Start(uint16_t Period_10ms);
+void TELEMETRY_TimeSlice10ms(void);
+void TELEMETRY_Send(void);
+void TELEMETRY_EndFrame(void);
+
+#endif
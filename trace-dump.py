@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+
+# Flight recorder dump
+#
+# Reads the trace ring of a radio built with ENABLE_TRACE=1 over the
+# programming cable (UART command 0x0533) and prints the events with their
+# time since boot. The raw dump can be saved and decoded again later.
+#
+# A radio built with ENABLE_REG_TRACE=1 can also stream the trace, every
+# BK4819 register access included, until Ctrl-C. replay/ runs such a
+# capture through the host build of the firmware.
+#
+#   ./trace-dump.py /dev/ttyUSB0
+#   ./trace-dump.py /dev/ttyUSB0 --save field.trace
+#   ./trace-dump.py --load field.trace
+#   ./trace-dump.py /dev/ttyUSB0 --capture session.trace
+
+import argparse
+import struct
+import sys
+
+BAUDRATE = 38400
+TIMEOUT  = 1.0
+
+OBFUSCATION = [0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80]
+
+ENTRY = struct.Struct('<IBBH')     # TRACE_Entry_t
+REPLY = struct.Struct('<HHIIB3x')  # REPLY_0533_t up to Entries
+RAW   = struct.Struct('<IIBBH')    # saved dumps: sequence number + TRACE_Entry_t
+
+FUNCTIONS = ['FOREGROUND', 'TRANSMIT', 'MONITOR', 'INCOMING', 'RECEIVE', 'POWER_SAVE', 'BAND_SCOPE']
+
+IRQ_BITS = ['', 'fskRxSync', 'sqlLost', 'sqlFound', 'voxLost', 'voxFound', 'ctcssLost', 'ctcssFound',
+            'cdcssLost', 'cdcssFound', 'cssTailFound', 'dtmf5ToneFound', 'fskFifoAlmostFull',
+            'fskRxFinished', 'fskFifoAlmostEmpty', 'fskTxFinished']
+
+def function_name(f):
+    return FUNCTIONS[f] if f < len(FUNCTIONS) else str(f)
+
+def freq(arg, aux):
+    f = aux << 16 | arg    # 100Hz
+    return '%u.%04u MHz' % (f // 10000, f % 10000)
+
+def register(arg, aux):
+    return 'REG_%02X %04X' % (aux, arg)
+
+# keep in step with TRACE_Id_t in trace.h
+EVENTS = {
+    1:  ('FUNCTION',     lambda a, x: '%s -> %s' % (function_name(a >> 8), function_name(a & 0xFF))),
+    2:  ('BK4819_IRQ',   lambda a, x: ' '.join(n for i, n in enumerate(IRQ_BITS) if n and a & (1 << i)) or '%04X' % a),
+    3:  ('SCAN_CHANNEL', lambda a, x: 'channel %u' % (a + 1)),
+    4:  ('SCAN_FREQ',    lambda a, x: freq(a, x)),
+    5:  ('SQUELCH',      lambda a, x: 'open' if a else 'closed'),
+    6:  ('EEPROM_WRITE', lambda a, x: '0x%04X' % a),
+    7:  ('TX_START',     lambda a, x: freq(a, x)),
+    8:  ('TX_STOP',      lambda a, x: ''),
+    9:  ('BK4819_READ',  register),
+    10: ('BK4819_WRITE', register),
+}
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+def crc16_xmodem(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+    return crc & 0xFFFF
+
+def send_command(port, data):
+    body = data + struct.pack('<H', crc16_xmodem(data))
+    port.write(struct.pack('>HBB', 0xABCD, len(data), 0) + obfuscate(body) + struct.pack('>H', 0xDCBA))
+
+def receive_reply(port):
+    header = port.read(4)
+    if len(header) != 4 or header[0] != 0xAB or header[1] != 0xCD:
+        sys.exit('no reply from the radio')
+    size   = header[2] | header[3] << 8
+    body   = port.read(size)
+    footer = port.read(4)
+    if len(body) != size or len(footer) != 4 or footer[2] != 0xDC or footer[3] != 0xBA:
+        sys.exit('bad reply from the radio')
+    return obfuscate(body)
+
+def read_trace(port):
+    # session hello, the firmware answers with its version
+    send_command(port, struct.pack('<HHI', 0x0514, 4, 0x6457396A))
+    receive_reply(port)
+
+    entries = []
+    index   = 0
+    while True:
+        send_command(port, struct.pack('<HHI', 0x0533, 4, index))
+        reply = receive_reply(port)
+        cmd_id, _, head, first, count = REPLY.unpack_from(reply)
+        if cmd_id != 0x0534:
+            sys.exit('radio does not answer 0x0533, is it built with ENABLE_TRACE=1 ?')
+        for i in range(count):
+            entries.append((first + i,) + ENTRY.unpack_from(reply, REPLY.size + i * ENTRY.size))
+        if count == 0 or first + count >= head:
+            return entries
+        index = first + count
+
+def capture(port, path):
+    send_command(port, struct.pack('<HHI', 0x0514, 4, 0x6457396A))
+    receive_reply(port)
+    send_command(port, struct.pack('<HHB3x', 0x0535, 4, 1))
+
+    count = 0
+    lost  = 0
+    expected = None
+    print('capturing to %s, Ctrl-C to stop' % path)
+    with open(path, 'wb') as f:
+        try:
+            while True:
+                # 0xAA 0x55 type size(BE16) payload 0x0A, screenshots share the framing
+                if port.read(1) != b'\xAA' or port.read(1) != b'\x55':
+                    continue
+                header = port.read(3)
+                if len(header) != 3:
+                    continue
+                size    = header[1] << 8 | header[2]
+                payload = port.read(size)
+                if port.read(1) != b'\x0A' or len(payload) != size or header[0] != 0x03:
+                    continue
+                seq = struct.unpack_from('<I', payload)[0]
+                if expected is not None and seq != expected:
+                    lost += seq - expected
+                for i in range((size - 4) // ENTRY.size):
+                    f.write(RAW.pack(seq + i, *ENTRY.unpack_from(payload, 4 + i * ENTRY.size)))
+                count   += (size - 4) // ENTRY.size
+                expected = seq + (size - 4) // ENTRY.size
+        except KeyboardInterrupt:
+            pass
+
+    send_command(port, struct.pack('<HHB3x', 0x0535, 4, 0))
+    print('%u events captured, %u lost to UART overruns' % (count, lost))
+
+def time_us(t):
+    # 10ms ticks << 12 | SysTick counts / 128 at 48MHz
+    return (t >> 12) * 10000 + (t & 0xFFF) * 128 // 48
+
+def print_trace(entries):
+    if not entries:
+        print('trace is empty')
+        return
+    if entries[0][0] > 0:
+        print('(%u earlier events not in the dump)' % entries[0][0])
+
+    previous = None
+    for seq, t, event, aux, arg in entries:
+        us    = time_us(t)
+        delta = '' if previous is None else '+%u' % (us - previous)
+        name, decode = EVENTS.get(event, ('EVENT_%u' % event, lambda a, x: '%02X %04X' % (x, a)))
+        print('%6u %10u.%03u ms %10s  %-13s %s' % (seq, us // 1000, us % 1000, delta, name, decode(arg, aux)))
+        previous = us
+
+def main():
+    parser = argparse.ArgumentParser(description='Read and decode the radio flight recorder')
+    parser.add_argument('port', nargs='?', help='serial port of the programming cable')
+    parser.add_argument('--save', help='also write the raw dump to this file')
+    parser.add_argument('--load', help='decode a raw dump saved earlier instead of reading the radio')
+    parser.add_argument('--capture', help='stream the trace of an ENABLE_REG_TRACE build to this file')
+    args = parser.parse_args()
+
+    if args.load:
+        with open(args.load, 'rb') as f:
+            raw = f.read()
+        entries = list(RAW.iter_unpack(raw))
+    elif args.port and args.capture:
+        import serial
+        with serial.Serial(args.port, BAUDRATE, timeout=TIMEOUT) as port:
+            capture(port, args.capture)
+        return
+    elif args.port:
+        import serial
+        with serial.Serial(args.port, BAUDRATE, timeout=TIMEOUT) as port:
+            entries = read_trace(port)
+    else:
+        parser.error('give the serial port or --load')
+
+    if args.save:
+        with open(args.save, 'wb') as f:
+            for entry in entries:
+                f.write(RAW.pack(*entry))
+
+    print_trace(entries)
+
+if __name__ == '__main__':
+    main()
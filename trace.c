@@ -0,0 +1,147 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "ARMCM0.h"
+#ifdef ENABLE_REG_TRACE
+    #include "driver/bk4819-regs.h"
+    #include "driver/uart.h"
+#endif
+#include "misc.h"
+#include "trace.h"
+
+TRACE_Entry_t     gTrace[TRACE_LEN];
+volatile uint32_t gTraceHead;
+
+void TRACE_Record(TRACE_Id_t Id, uint8_t Aux, uint16_t Arg)
+{
+    // the tick interrupt may come in between, keep the slot and stamp consistent
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    TRACE_Entry_t *pEntry = &gTrace[gTraceHead++ % TRACE_LEN];
+    pEntry->Time = (gGlobalSysTickCounter << 12) | ((SysTick->LOAD - SysTick->VAL) >> 7);
+    pEntry->Id   = Id;
+    pEntry->Aux  = Aux;
+    pEntry->Arg  = Arg;
+
+    __set_PRIMASK(primask);
+}
+
+#ifdef ENABLE_REG_TRACE
+
+#define STREAM_ENTRIES 8
+
+bool gTraceStreaming;
+
+static uint16_t gLastRead[0x80];
+static uint8_t  gLastReadValid[0x80 / 8];
+
+static uint32_t gStreamNext;   // sequence number of the next entry to send
+
+// 0xAA 0x55 0x03, size BE16, first sequence number LE32, entries, 0x0A
+// framed like the screenshots so one reader on the host can take both
+static uint8_t  gFrame[5 + 4 + STREAM_ENTRIES * sizeof(TRACE_Entry_t) + 1];
+static uint8_t  gFrameSize;
+static uint8_t  gFramePos;
+
+void TRACE_BK4819(TRACE_Id_t Id, uint8_t Register, uint16_t Value)
+{
+    if (!gTraceStreaming)
+        return;
+
+    Register &= 0x7F;
+
+    // every REG_02 read is an interrupt going by, even the same one twice
+    if (Id == TRACE_BK4819_READ && Register != BK4819_REG_02) {
+        const uint8_t bit = 1u << (Register % 8);
+        if ((gLastReadValid[Register / 8] & bit) && gLastRead[Register] == Value)
+            return;
+        gLastReadValid[Register / 8] |= bit;
+        gLastRead[Register] = Value;
+    }
+
+    TRACE_Record(Id, Register, Value);
+}
+
+void TRACE_StreamStart(void)
+{
+    memset(gLastReadValid, 0, sizeof(gLastReadValid));
+    gFrameSize      = 0;
+    gFramePos       = 0;
+    gStreamNext     = gTraceHead;
+    gTraceStreaming = true;
+}
+
+static bool NextFrame(void)
+{
+    const uint32_t Head = gTraceHead;
+    unsigned int   Count = 0;
+
+    // entries overwritten before they got out are dropped, the receiver sees
+    // the gap in the sequence numbers
+    if (Head - gStreamNext > TRACE_LEN)
+        gStreamNext = Head - TRACE_LEN;
+
+    if (gStreamNext == Head)
+        return false;
+
+    memcpy(&gFrame[5], &gStreamNext, 4);
+    while (gStreamNext != Head && Count < STREAM_ENTRIES)
+        memcpy(&gFrame[9 + Count++ * sizeof(TRACE_Entry_t)], &gTrace[gStreamNext++ % TRACE_LEN], sizeof(TRACE_Entry_t));
+
+    const uint16_t Size = 4 + Count * sizeof(TRACE_Entry_t);
+    gFrame[0] = 0xAA;
+    gFrame[1] = 0x55;
+    gFrame[2] = 0x03;
+    gFrame[3] = Size >> 8;
+    gFrame[4] = Size & 0xFF;
+    gFrame[5 + Size] = 0x0A;
+
+    gFrameSize = 5 + Size + 1;
+    gFramePos  = 0;
+
+    return true;
+}
+
+void TRACE_Stream(void)
+{
+    if (!gTraceStreaming)
+        return;
+
+    while (1) {
+        if (gFramePos == gFrameSize && !NextFrame())
+            return;
+
+        const uint32_t Sent = UART_TrySend(&gFrame[gFramePos], gFrameSize - gFramePos);
+        gFramePos += Sent;
+        if (gFramePos != gFrameSize)
+            return;   // the FIFO is full
+    }
+}
+
+// command replies must not land in the middle of a frame
+void TRACE_StreamEndFrame(void)
+{
+    if (gFramePos != gFrameSize) {
+        UART_Send(&gFrame[gFramePos], gFrameSize - gFramePos);
+        gFramePos = gFrameSize;
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// flight recorder, the last TRACE_LEN events kept in RAM and read out
+// over the UART (see trace-dump.py), TRACE() compiles to nothing without
+// ENABLE_TRACE
+//
+// ENABLE_REG_TRACE adds every BK4819 register access and streams the ring
+// out over the UART as it fills, for the host replay (see replay/)
+
+enum TRACE_Id_t {
+    TRACE_FUNCTION = 1,    // arg: previous function << 8 | new function
+    TRACE_BK4819_IRQ,      // arg: REG_02 interrupt bits
+    TRACE_SCAN_CHANNEL,    // arg: channel
+    TRACE_SCAN_FREQ,       // aux << 16 | arg: frequency in 100Hz
+    TRACE_SQUELCH,         // arg: 1 open, 0 closed
+    TRACE_EEPROM_WRITE,    // arg: address
+    TRACE_TX_START,        // aux << 16 | arg: frequency in 100Hz
+    TRACE_TX_STOP,         // arg: 0
+    TRACE_BK4819_READ,     // aux: register, arg: value
+    TRACE_BK4819_WRITE,    // aux: register, arg: value
+};
+
+typedef enum TRACE_Id_t TRACE_Id_t;
+
+#ifdef ENABLE_TRACE
+
+    #ifdef ENABLE_REG_TRACE
+        #define TRACE_LEN 256   // power of 2, room for a retune burst while the UART catches up
+    #else
+        #define TRACE_LEN 64    // power of 2
+    #endif
+
+    // Time: 10ms ticks << 12 | 2.67us steps into the tick
+    typedef struct {
+        uint32_t Time;
+        uint8_t  Id;
+        uint8_t  Aux;
+        uint16_t Arg;
+    } TRACE_Entry_t;
+
+    extern TRACE_Entry_t     gTrace[TRACE_LEN];
+    extern volatile uint32_t gTraceHead;   // events recorded since boot
+
+    void TRACE_Record(TRACE_Id_t Id, uint8_t Aux, uint16_t Arg);
+
+    #define TRACE(id, arg) TRACE_Record(id, 0, arg)
+
+    // a frequency in 10Hz as 24 bits of 100Hz, up to 1677MHz
+    #define TRACE_FREQ(id, freq) TRACE_Record(id, (freq) / 10 >> 16, (freq) / 10)
+
+#else
+
+    #define TRACE(id, arg) do {} while (0)
+    #define TRACE_FREQ(id, freq) do {} while (0)
+
+#endif
+
+#ifdef ENABLE_REG_TRACE
+
+    extern bool gTraceStreaming;
+
+    // reads that return what the register gave last time are left out,
+    // the replay holds the last value
+    void TRACE_BK4819(TRACE_Id_t Id, uint8_t Register, uint16_t Value);
+    void TRACE_StreamStart(void);
+    void TRACE_Stream(void);       // non blocking, from the main loops
+    void TRACE_StreamEndFrame(void);
+
+#else
+
+    #define TRACE_BK4819(id, reg, value) do {} while (0)
+
+#endif
+
+#endif
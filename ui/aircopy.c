@@ -44,15 +44,16 @@ void UI_DisplayAircopy(void)
     UI_DisplayClear();
 
     if (gAircopyState == AIRCOPY_READY) {
-        pPrintStr = "AIR COPY(RDY)";
+        pPrintStr = "(RDY)";
     } else if (gAircopyState == AIRCOPY_TRANSFER) {
-        pPrintStr = "AIR COPY";
+        pPrintStr = "";
     } else {
-        pPrintStr = "AIR COPY(CMP)";
+        pPrintStr = (gAircopyState == AIRCOPY_FAILED) ? "(ERR)" : "(CMP)";
         gAircopyState = AIRCOPY_READY;
     }
 
-    UI_PrintString(pPrintStr, 2, 127, 0, 8);
+    sprintf(String, "AIR %s%s", gAirCopyDelta ? "DELTA" : gAirCopyAck ? "ACK" : "COPY", pPrintStr);
+    UI_PrintString(String, 2, 127, 0, 8);
 
     if (gInputBoxIndex == 0) {
         uint32_t frequency = gRxVfo->freq_config_RX.Frequency;
@@ -70,10 +71,12 @@ void UI_DisplayAircopy(void)
 
     memset(String, 0, sizeof(String));
 
-    percent = (gAirCopyBlockNumber * 10000) / 120;
+    percent = (gAirCopyBlockNumber * 10000) / (gAirCopyAck ? AIRCOPY_ACK_BLOCKS : AIRCOPY_BLOCKS);
 
     if (gAirCopyIsSendMode == 0) {
         sprintf(String, "RCV:%02u.%02u%% E:%d", percent / 100, percent % 100, gErrorsDuringAirCopy);
+    } else if (gAirCopyAck) {
+        sprintf(String, "SND:%02u.%02u%% E:%d", percent / 100, percent % 100, gErrorsDuringAirCopy);
     } else if (gAirCopyIsSendMode == 1) {
         sprintf(String, "SND:%02u.%02u%%", percent / 100, percent % 100);
     }
@@ -95,7 +98,21 @@ void UI_DisplayAircopy(void)
         gFrameBuffer[4][126] = 0x3c;
     }
 
-    if(gAirCopyBlockNumber + gErrorsDuringAirCopy != 0)
+    if(gAirCopyAck)
+    {
+        // the blocks held, in any order
+        for(uint8_t i = 0; i < AIRCOPY_ACK_BLOCKS; i++)
+        {
+            if(get_bit(gAirCopyBlocks, i))
+            {
+                for(uint8_t x = i * 122 / AIRCOPY_ACK_BLOCKS; x < (i + 1) * 122 / AIRCOPY_ACK_BLOCKS; x++)
+                {
+                    gFrameBuffer[4][x + 4] = 0xbd;
+                }
+            }
+        }
+    }
+    else if(gAirCopyBlockNumber + gErrorsDuringAirCopy != 0)
     {
         // Check CRC
         if(gErrorsDuringAirCopy != lErrorsDuringAirCopy)
@@ -19,6 +19,7 @@
 #include "driver/st7565.h"
 #include "external/printf/printf.h"
 #include "font.h"
+#include "frequencies.h"
 #include "ui/helper.h"
 #include "ui/inputbox.h"
 #include "misc.h"
@@ -65,46 +66,71 @@ void UI_GenerateChannelStringEx(char *pString, const bool bShowPrefix, const uin
     }
 }
 
+// the fonts are fixed width, so a string is drawn in a single pass and only
+// needs measuring (strlen) when it has to be centred
+
 void UI_PrintStringBuffer(const char *pString, uint8_t * buffer, uint32_t char_width, const uint8_t *font)
 {
-    const size_t Length = strlen(pString);
     const unsigned int char_spacing = char_width + 1;
-    for (size_t i = 0; i < Length; i++) {
-        const unsigned int index = pString[i] - ' ' - 1;
-        if (pString[i] > ' ' && pString[i] < 127) {
-            const uint32_t offset = i * char_spacing + 1;
-            memcpy(buffer + offset, font + index * char_width, char_width);
-        }
+    for (; *pString != 0; pString++, buffer += char_spacing) {
+        const unsigned int index = *pString - ' ' - 1;
+        if (*pString > ' ' && *pString < 127)
+            memcpy(buffer + 1, font + index * char_width, char_width);
     }
 }
 
-void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width)
+// "%3u.%05u" without the printf machinery, returns the end of the string
+static char *UI_FormatFrequency(char *pString, const uint32_t frequency)
 {
-    size_t i;
-    size_t Length = strlen(pString);
+    uint32_t     mhz = frequency / 100000;
+    uint32_t     dec = frequency % 100000;
+    unsigned int len = 0;
+    char         digits[5];
+
+    do {
+        digits[len++] = '0' + mhz % 10;
+        mhz /= 10;
+    } while (mhz > 0 && len < ARRAY_SIZE(digits));
+
+    for (unsigned int i = len; i < 3; i++)
+        *pString++ = ' ';
+    while (len > 0)
+        *pString++ = digits[--len];
+
+    *pString++ = '.';
+    for (int i = 4; i >= 0; i--, dec /= 10)
+        pString[i] = '0' + dec % 10;
+    pString   += 5;
+    *pString   = 0;
+
+    return pString;
+}
 
+void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width)
+{
     if (End > Start)
-        Start += (((End - Start) - (Length * Width)) + 1) / 2;
+        Start += (((End - Start) - (strlen(pString) * Width)) + 1) / 2;
 
-    for (i = 0; i < Length; i++)
+    uint8_t *pFb0 = gFrameBuffer[Line + 0] + Start;
+    uint8_t *pFb1 = gFrameBuffer[Line + 1] + Start;
+
+    for (; *pString != 0; pString++, pFb0 += Width, pFb1 += Width)
     {
-        const unsigned int ofs   = (unsigned int)Start + (i * Width);
-        if (pString[i] > ' ' && pString[i] < 127)
+        if (*pString > ' ' && *pString < 127)
         {
-            const unsigned int index = pString[i] - ' ' - 1;
-            memcpy(gFrameBuffer[Line + 0] + ofs, &gFontBig[index][0], 7);
-            memcpy(gFrameBuffer[Line + 1] + ofs, &gFontBig[index][7], 7);
+            const unsigned int index = *pString - ' ' - 1;
+            memcpy(pFb0, &gFontBig[index][0], 7);
+            memcpy(pFb1, &gFontBig[index][7], 7);
         }
     }
 }
 
 void UI_PrintStringSmall(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t char_width, const uint8_t *font)
 {
-    const size_t Length = strlen(pString);
     const unsigned int char_spacing = char_width + 1;
 
     if (End > Start) {
-        Start += (((End - Start) - Length * char_spacing) + 1) / 2;
+        Start += (((End - Start) - strlen(pString) * char_spacing) + 1) / 2;
     }
 
     UI_PrintStringBuffer(pString, gFrameBuffer[Line] + Start, char_width, font);
@@ -181,6 +207,52 @@ void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center)
     }
 }
 
+static void UI_DrawBigDigit(uint8_t *pFb0, const unsigned int digit)
+{
+    memcpy(pFb0 + 2,       gFontBigDigits[digit],      10);
+    memcpy(pFb0 + 2 + 128, gFontBigDigits[digit] + 10, 10);
+}
+
+void UI_DisplayFrequencyBig(const uint32_t frequency, const uint8_t X, const uint8_t Line)
+{
+    if (frequency < _1GHz_in_KHz) {
+        // digits straight from the value, same layout as UI_DisplayFrequency("%3u.%03u")
+        const uint32_t mhz  = frequency / 100000;
+        const uint32_t dec  = frequency % 100000;
+        const uint32_t khz  = dec / 100;
+        const uint32_t hz10 = dec % 100;
+        uint8_t       *pFb0 = gFrameBuffer[Line] + X;
+
+        if (mhz >= 100)
+            UI_DrawBigDigit(pFb0, mhz / 100);
+        pFb0 += 13;
+        if (mhz >= 10)
+            UI_DrawBigDigit(pFb0, (mhz / 10) % 10);
+        pFb0 += 13;
+        UI_DrawBigDigit(pFb0, mhz % 10);
+        pFb0 += 13;
+
+        pFb0[128] = 0x60;
+        pFb0[129] = 0x60;
+        pFb0[130] = 0x60;
+        pFb0 += 3;
+
+        UI_DrawBigDigit(pFb0,      khz / 100);
+        UI_DrawBigDigit(pFb0 + 13, (khz / 10) % 10);
+        UI_DrawBigDigit(pFb0 + 26, khz % 10);
+
+        // the remaining 2 digits in the small font at the right edge
+        uint8_t *pSmall = gFrameBuffer[Line + 1] + X + 81;
+        memcpy(pSmall + 1, gFontSmall['0' - ' ' - 1 + hz10 / 10], ARRAY_SIZE(gFontSmall[0]));
+        memcpy(pSmall + 1 + ARRAY_SIZE(gFontSmall[0]) + 1, gFontSmall['0' - ' ' - 1 + hz10 % 10], ARRAY_SIZE(gFontSmall[0]));
+        return;
+    }
+
+    char String[16];
+    UI_FormatFrequency(String, frequency);
+    UI_PrintString(String, X, 0, Line, 8);
+}
+
 /*
 void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center)
 {
@@ -346,6 +418,70 @@ void UI_DisplayPopup(const char *string)
     UI_PrintStringSmallNormal("Press EXIT", 9, 118, 6);
 }
 
+static struct {
+    void  (*draw)(void);   // NULL while no popup is open
+    uint8_t line;
+    uint8_t lines;
+    uint8_t saved[POPUP_SAVE_LINES][LCD_WIDTH];
+} popup;
+
+static void UI_PopupBlit(void)
+{
+    for (uint8_t i = 0; i < popup.lines; i++)
+        ST7565_BlitLine(popup.line + i);
+}
+
+void UI_PopupOpen(uint8_t line, uint8_t lines, void (*draw)(void), bool now)
+{
+    if (popup.draw == draw && popup.line == line)
+        return;     // already on top
+
+    UI_PopupClose(now);
+
+    if (line + lines > FRAME_LINES)
+        lines = FRAME_LINES - line;
+
+    popup.draw  = draw;
+    popup.line  = line;
+    popup.lines = lines;
+
+    if (lines <= POPUP_SAVE_LINES)
+        memcpy(popup.saved, gFrameBuffer[line], lines * LCD_WIDTH);
+    memset(gFrameBuffer[line], 0, lines * LCD_WIDTH);
+    draw();
+
+    if (now)
+        UI_PopupBlit();
+}
+
+void UI_PopupClose(bool now)
+{
+    if (popup.draw == NULL)
+        return;
+
+    popup.draw = NULL;
+
+    if (popup.lines > POPUP_SAVE_LINES) {
+        gUpdateDisplay = true;  // nothing kept, render the screen below again
+        return;
+    }
+
+    memcpy(gFrameBuffer[popup.line], popup.saved, popup.lines * LCD_WIDTH);
+
+    if (now)
+        UI_PopupBlit();
+}
+
+void UI_PopupDiscard(void)
+{   // the frame buffer is about to be redrawn, nothing to put back
+    popup.draw = NULL;
+}
+
+bool UI_PopupCovers(uint8_t line)
+{
+    return popup.draw != NULL && line >= popup.line && line < popup.line + popup.lines;
+}
+
 void UI_DisplayClear()
 {
     memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
@@ -28,9 +28,26 @@ void UI_PrintStringSmallBold(const char *pString, uint8_t Start, uint8_t End, ui
 void UI_PrintStringSmallBufferNormal(const char *pString, uint8_t *buffer);
 void UI_PrintStringSmallBufferBold(const char *pString, uint8_t * buffer);
 void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center);
+// "%3u.%05u" at X on Line/Line+1, big digits with the last two small, main font from 1 GHz
+void UI_DisplayFrequencyBig(const uint32_t frequency, const uint8_t X, const uint8_t Line);
 
 void UI_DisplayPopup(const char *string);
 
+// popup layer, a popup covers whole frame buffer lines on top of the screen
+// below it, a popup of up to POPUP_SAVE_LINES lines keeps those bytes aside
+// and puts them back when it closes, a bigger one has the screen re-rendered
+//
+// 1 line covers the F4HWN key lock hint, the one shown and dismissed all the
+// time. The UI_DisplayPopup() low battery screen (all FRAME_LINES lines, it
+// clears the whole frame buffer) and the stock 4 line key lock hint still
+// re-render, keeping them would hold 896 bytes of RAM for a rare event
+#define POPUP_SAVE_LINES 1
+
+void UI_PopupOpen(uint8_t line, uint8_t lines, void (*draw)(void), bool now);
+void UI_PopupClose(bool now);
+void UI_PopupDiscard(void);
+bool UI_PopupCovers(uint8_t line);
+
 void UI_DrawPixelBuffer(uint8_t (*buffer)[128], uint8_t x, uint8_t y, bool black);
 #ifdef ENABLE_FEAT_F4HWN
     //void UI_DrawLineDottedBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black);
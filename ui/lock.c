@@ -49,7 +49,7 @@ static void Render(void)
 
 void UI_DisplayLock(void)
 {
-    KEY_Code_t  Key;
+    KEY_Event_t Event;
     BEEP_Type_t Beep;
 
     gUpdateDisplay = true;
@@ -64,83 +64,67 @@ void UI_DisplayLock(void)
 
         gNextTimeslice = false;
 
-        Key = KEYBOARD_Poll();
+        KEYBOARD_Update(&gKeyboard, KEYBOARD_Poll(), &key_timing);
 
-        if (gKeyReading0 == Key)
+        while (KEYBOARD_GetEvent(&Event))
         {
-            if (++gDebounceCounter == key_debounce_10ms)
+            if (Event.Type != KEY_EVENT_PRESS)
+                continue;
+
+            switch (Event.Key)
             {
-                if (Key == KEY_INVALID)
-                {
-                    gKeyReading1 = KEY_INVALID;
-                }
-                else
-                {
-                    gKeyReading1 = Key;
-
-                    switch (Key)
+                case KEY_0:
+                case KEY_1:
+                case KEY_2:
+                case KEY_3:
+                case KEY_4:
+                case KEY_5:
+                case KEY_6:
+                case KEY_7:
+                case KEY_8:
+                case KEY_9:
+                    INPUTBOX_Append(Event.Key - KEY_0);
+
+                    if (gInputBoxIndex < 6)   // 6 frequency digits
+                    {
+                        Beep = BEEP_1KHZ_60MS_OPTIONAL;
+                    }
+                    else
                     {
-                        case KEY_0:
-                        case KEY_1:
-                        case KEY_2:
-                        case KEY_3:
-                        case KEY_4:
-                        case KEY_5:
-                        case KEY_6:
-                        case KEY_7:
-                        case KEY_8:
-                        case KEY_9:
-                            INPUTBOX_Append(Key - KEY_0);
-
-                            if (gInputBoxIndex < 6)   // 6 frequency digits
-                            {
-                                Beep = BEEP_1KHZ_60MS_OPTIONAL;
-                            }
-                            else
-                            {
-                                uint32_t Password;
-
-                                gInputBoxIndex = 0;
-                                Password = StrToUL(INPUTBOX_GetAscii());
-
-                                if ((gEeprom.POWER_ON_PASSWORD) == Password)
-                                {
-                                    AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
-                                    return;
-                                }
-
-                                memset(gInputBox, 10, sizeof(gInputBox));
-
-                                Beep = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
-                            }
-
-                            AUDIO_PlayBeep(Beep);
-
-                            gUpdateDisplay = true;
-                            break;
-
-                        case KEY_EXIT:
-                            if (gInputBoxIndex > 0)
-                            {
-                                gInputBox[--gInputBoxIndex] = 10;
-                                gUpdateDisplay = true;
-                            }
+                        uint32_t Password;
+
+                        gInputBoxIndex = 0;
+                        Password = StrToUL(INPUTBOX_GetAscii());
 
+                        if ((gEeprom.POWER_ON_PASSWORD) == Password)
+                        {
                             AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
+                            return;
+                        }
 
-                        default:
-                            break;
+                        memset(gInputBox, 10, sizeof(gInputBox));
+
+                        Beep = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
                     }
-                }
 
-                gKeyBeingHeld = false;
+                    AUDIO_PlayBeep(Beep);
+
+                    gUpdateDisplay = true;
+                    break;
+
+                case KEY_EXIT:
+                    if (gInputBoxIndex > 0)
+                    {
+                        gInputBox[--gInputBoxIndex] = 10;
+                        gUpdateDisplay = true;
+                    }
+
+                    AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
+
+                default:
+                    break;
             }
         }
-        else
-        {
-            gDebounceCounter = 0;
-            gKeyReading0     = Key;
-        }
 
 #ifdef ENABLE_UART
         if (UART_IsCommandAvailable())
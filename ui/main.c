@@ -166,6 +166,13 @@ static void DrawLevelBar(uint8_t xpos, uint8_t line, uint8_t level, uint8_t bars
 
 #ifdef ENABLE_AUDIO_BAR
 
+// the TX audio meter owns these columns of the center line, a refresh only
+// sends the columns whose bars changed since the last one to the display
+#define AUDIO_BAR_X      2
+#define AUDIO_BAR_BARS   25
+
+static uint8_t audioBarDrawn = UINT8_MAX;   // bars on the display, UINT8_MAX once the screen got redrawn
+
 // Approximation of a logarithmic scale using integer arithmetic
 uint8_t log2_approx(unsigned int value) {
     uint8_t log = 0;
@@ -199,6 +206,9 @@ void UI_DisplayAudioBar(void)
         const unsigned int line = 3;
 #endif
 
+        if (UI_PopupCovers(line))
+            return;  // the popup is on top
+
         if (gCurrentFunction != FUNCTION_TRANSMIT ||
             gScreenToDisplay != DISPLAY_MAIN
 #ifdef ENABLE_DTMF_CALLING
@@ -227,13 +237,27 @@ void UI_DisplayAudioBar(void)
         bars = barsList[logLevel];
         barsOld = (barsOld - bars > 1) ? (barsOld - 1) : bars;
 
+        if (barsOld == audioBarDrawn)
+            return;   // nothing changed
+
         uint8_t *p_line = gFrameBuffer[line];
-        memset(p_line, 0, LCD_WIDTH);
+        unsigned first  = 0;
+        unsigned last   = LCD_WIDTH;
 
-        DrawLevelBar(2, line, barsOld, 25);
+        if (audioBarDrawn > AUDIO_BAR_BARS) {
+            memset(p_line, 0, LCD_WIDTH);
+        }
+        else {
+            first = AUDIO_BAR_X + MIN(barsOld, audioBarDrawn) * 5;
+            last  = AUDIO_BAR_X + MAX(barsOld, audioBarDrawn) * 5;
+            memset(p_line + first, 0, last - first);
+        }
+
+        DrawLevelBar(AUDIO_BAR_X, line, barsOld, AUDIO_BAR_BARS);
+        audioBarDrawn = barsOld;
 
         if (gCurrentFunction == FUNCTION_TRANSMIT)
-            ST7565_BlitFullScreen();
+            ST7565_BlitLineRange(line, first, last - first);
     }
 }
 #endif
@@ -272,7 +296,7 @@ void DisplayRSSIBar(const bool now)
     //sprintf(String, "%d", RxBlink);
     //UI_PrintStringSmallBold(String, 80, 0, RxLine);
 
-    if(RxLine >= 0 && center_line != CENTER_LINE_IN_USE)
+    if(RxLine >= 0 && center_line != CENTER_LINE_IN_USE && !UI_PopupCovers(RxLine))
     {
         if (RxBlink == 0 || RxBlink == 1) {
             UI_PrintStringSmallBold("RX", 8, 0, RxLine);
@@ -284,7 +308,7 @@ void DisplayRSSIBar(const bool now)
             }
             RxBlink = 1;
         }
-        ST7565_BlitLine(RxLine);
+        ST7565_BlitLineRange(RxLine, 8, 16);
     }
 #else
     const unsigned int line = 3;
@@ -304,7 +328,7 @@ void DisplayRSSIBar(const bool now)
     };
 #endif
 
-    if ((gEeprom.KEY_LOCK && gKeypadLocked > 0) || center_line != CENTER_LINE_RSSI)
+    if ((gEeprom.KEY_LOCK && gKeypadLocked > 0) || center_line != CENTER_LINE_RSSI || UI_PopupCovers(line))
         return;     // display is in use
 
     if (gCurrentFunction == FUNCTION_TRANSMIT ||
@@ -322,7 +346,7 @@ void DisplayRSSIBar(const bool now)
     int16_t rssi_dBm =
         BK4819_GetRSSI_dBm()
 #ifdef ENABLE_AM_FIX
-        + ((gSetting_AM_fix && gRxVfo->Modulation == MODULATION_AM) ? AM_fix_get_gain_diff() : 0)
+        + (AM_fix_is_active(gRxVfo->Modulation) ? AM_fix_get_gain_diff() : 0)
 #endif
         + dBmCorrTable[gRxVfo->Band];
 
@@ -348,7 +372,7 @@ void DisplayRSSIBar(const bool now)
     const int16_t rssi_dBm =
         BK4819_GetRSSI_dBm()
 #ifdef ENABLE_AM_FIX
-        + ((gSetting_AM_fix && gRxVfo->Modulation == MODULATION_AM) ? AM_fix_get_gain_diff() : 0)
+        + (AM_fix_is_active(gRxVfo->Modulation) ? AM_fix_get_gain_diff() : 0)
 #endif
         + dBmCorrTable[gRxVfo->Band];
 
@@ -411,12 +435,13 @@ void DisplayRSSIBar(const bool now)
         Level = 0;
     }
 
-    uint8_t *pLine = (gEeprom.RX_VFO == 0)? gFrameBuffer[2] : gFrameBuffer[6];
+    const unsigned line  = (gEeprom.RX_VFO == 0) ? 2 : 6;
+    uint8_t       *pLine = gFrameBuffer[line];
     if (now)
         memset(pLine, 0, 23);
     DrawSmallAntennaAndBars(pLine, Level);
     if (now)
-        ST7565_BlitFullScreen();
+        ST7565_BlitLineRange(line, 0, 23);
 #endif
 
 }
@@ -525,58 +550,64 @@ void UI_MAIN_TimeSlice500ms(void)
 
 // ***************************************************************************
 
-void UI_DisplayMain(void)
+static void DrawLowBatteryPopup(void)
 {
-    char               String[22];
-
-    center_line = CENTER_LINE_NONE;
+    UI_DisplayPopup("LOW BATTERY");
+}
 
-    // clear the screen
-    UI_DisplayClear();
+#ifdef ENABLE_FEAT_F4HWN
+static uint8_t KeyLockPopupLine(void)
+{
+    return isMainOnly() ? 5 : 3;
+}
+#endif
 
-    if(gLowBattery && !gLowBatteryConfirmed) {
-        UI_DisplayPopup("LOW BATTERY");
-        ST7565_BlitFullScreen();
-        return;
-    }
+static void DrawKeyLockPopup(void)
+{   // tell user how to unlock the keyboard
+#ifdef ENABLE_FEAT_F4HWN
+    UI_PrintStringSmallBold("UNLOCK KEYBOARD", 12, 0, KeyLockPopupLine());
+#else
+    UI_PrintString("Long press #", 0, LCD_WIDTH, 1, 8);
+    UI_PrintString("to unlock",    0, LCD_WIDTH, 3, 8);
+#endif
+}
 
-#ifndef ENABLE_FEAT_F4HWN
-    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
-    {   // tell user how to unlock the keyboard
-        UI_PrintString("Long press #", 0, LCD_WIDTH, 1, 8);
-        UI_PrintString("to unlock",    0, LCD_WIDTH, 3, 8);
-        ST7565_BlitFullScreen();
-        return;
-    }
+static void UI_MAIN_Popup(bool now)
+{
+    if (gLowBattery && !gLowBatteryConfirmed)
+        UI_PopupOpen(0, FRAME_LINES, DrawLowBatteryPopup, now);
+    else if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
+#ifdef ENABLE_FEAT_F4HWN
+        UI_PopupOpen(KeyLockPopupLine(), 1, DrawKeyLockPopup, now);
 #else
-    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
-    {   // tell user how to unlock the keyboard
-        uint8_t shift = 3;
+        UI_PopupOpen(1, 4, DrawKeyLockPopup, now);
+#endif
+    else
+        UI_PopupClose(now);
+}
 
-        /*
-        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, true);
-        SYSTEM_DelayMs(50);
-        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, false);
-        SYSTEM_DelayMs(50);
-        */
+void UI_MAIN_UpdatePopup(void)
+{   // show or dismiss the popup the state asks for, without a re-render of the screen
+    if (gScreenToDisplay == DISPLAY_MAIN)
+        UI_MAIN_Popup(true);
+}
 
-        if(isMainOnly())
-        {
-            shift = 5;
-        }
-        //memcpy(gFrameBuffer[shift] + 2, gFontKeyLock, sizeof(gFontKeyLock));
-        UI_PrintStringSmallBold("UNLOCK KEYBOARD", 12, 0, shift);
-        //memcpy(gFrameBuffer[shift] + 120, gFontKeyLock, sizeof(gFontKeyLock));
+void UI_DisplayMain(void)
+{
+    char               String[22];
 
-        /*
-        for (uint8_t i = 12; i < 116; i++)
-        {
-            gFrameBuffer[shift][i] ^= 0xFF;
-        }
-        */
-    }
+    center_line = CENTER_LINE_NONE;
+
+#ifdef ENABLE_AUDIO_BAR
+    audioBarDrawn = UINT8_MAX;
 #endif
 
+    // the popup is put back on top once the screen below is complete
+    UI_PopupDiscard();
+
+    // clear the screen
+    UI_DisplayClear();
+
     unsigned int activeTxVFO = gRxVfoIsActive ? gEeprom.RX_VFO : gEeprom.TX_VFO;
 
     for (unsigned int vfo_num = 0; vfo_num < 2; vfo_num++)
@@ -937,22 +968,13 @@ void UI_DisplayMain(void)
                 switch (gEeprom.CHANNEL_DISPLAY_MODE)
                 {
                     case MDF_FREQUENCY: // show the channel frequency
-                        sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
 #ifdef ENABLE_BIG_FREQ
-                        if(frequency < _1GHz_in_KHz) {
-                            // show the remaining 2 small frequency digits
-                            UI_PrintStringSmallNormal(String + 7, 113, 0, line + 1);
-                            String[7] = 0;
-                            // show the main large frequency digits
-                            UI_DisplayFrequency(String, 32, line, false);
-                        }
-                        else
+                        UI_DisplayFrequencyBig(frequency, 32, line);
+#else
+                        // show the frequency in the main font
+                        sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
+                        UI_PrintString(String, 32, 0, line, 8);
 #endif
-                        {
-                            // show the frequency in the main font
-                            UI_PrintString(String, 32, 0, line, 8);
-                        }
-
                         break;
 
                     case MDF_CHANNEL:   // show the channel number
@@ -995,19 +1017,7 @@ void UI_DisplayMain(void)
 #ifdef ENABLE_FEAT_F4HWN
                             if (isMainOnly())
                             {
-                                sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
-                                if(frequency < _1GHz_in_KHz) {
-                                    // show the remaining 2 small frequency digits
-                                    UI_PrintStringSmallNormal(String + 7, 113, 0, line + 4);
-                                    String[7] = 0;
-                                    // show the main large frequency digits
-                                    UI_DisplayFrequency(String, 32, line + 3, false);
-                                }
-                                else
-                                {
-                                    // show the frequency in the main font
-                                    UI_PrintString(String, 32, 0, line + 3, 8);
-                                }
+                                UI_DisplayFrequencyBig(frequency, 32, line + 3);
                             }
                             else
                             {
@@ -1025,22 +1035,13 @@ void UI_DisplayMain(void)
             }
             else
             {   // frequency mode
-                sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
-
 #ifdef ENABLE_BIG_FREQ
-                if(frequency < _1GHz_in_KHz) {
-                    // show the remaining 2 small frequency digits
-                    UI_PrintStringSmallNormal(String + 7, 113, 0, line + 1);
-                    String[7] = 0;
-                    // show the main large frequency digits
-                    UI_DisplayFrequency(String, 32, line, false);
-                }
-                else
+                UI_DisplayFrequencyBig(frequency, 32, line);
+#else
+                // show the frequency in the main font
+                sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
+                UI_PrintString(String, 32, 0, line, 8);
 #endif
-                {
-                    // show the frequency in the main font
-                    UI_PrintString(String, 32, 0, line, 8);
-                }
 
                 // show the channel symbols
                 const ChannelAttributes_t att = gMR_ChannelAttributes[gEeprom.ScreenChannel[vfo_num]];
@@ -1512,6 +1513,8 @@ void UI_DisplayMain(void)
     //#endif
 #endif
 
+    UI_MAIN_Popup(false);
+
     ST7565_BlitFullScreen();
 }
 
@@ -41,6 +41,7 @@ extern const int8_t dBmCorrTable[7];
 void UI_DisplayAudioBar(void);
 void UI_MAIN_TimeSlice500ms(void);
 void UI_DisplayMain(void);
+void UI_MAIN_UpdatePopup(void);
 
 #ifdef ENABLE_AGC_SHOW_DATA
 void UI_MAIN_PrintAGC(bool force);
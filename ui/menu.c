@@ -354,7 +354,8 @@ const char gSubMenu_BAT_TXT[][8] =
 {
     "NONE",
     "VOLTAGE",
-    "PERCENT"
+    "PERCENT",
+    "RUNTIME"
 };
 
 const char gSubMenu_BATTYP[][9] =
@@ -472,6 +473,7 @@ const t_sidefunction gSubMenu_SIDEFUNCTIONS[] =
 #endif
 #ifdef ENABLE_FMRADIO
     {"FM RADIO",        ACTION_OPT_FM},
+    {"FM SCAN",         ACTION_OPT_FM_SCAN},
 #endif
 #ifdef ENABLE_TX1750
     {"1750Hz",          ACTION_OPT_1750},
@@ -504,6 +506,49 @@ const t_sidefunction gSubMenu_SIDEFUNCTIONS[] =
 
 const uint8_t gSubMenu_SIDEFUNCTIONS_size = ARRAY_SIZE(gSubMenu_SIDEFUNCTIONS);
 
+// the string lists of the MENU_FORMAT_* formats, a row per value
+#define MENU_LIST(list) {(list)[0], sizeof((list)[0])}
+
+static const struct {
+    const char *strings;
+    uint8_t     stride;
+} MenuFormatLists[] = {
+    [MENU_FORMAT_OFF_ON]     = MENU_LIST(gSubMenu_OFF_ON),
+    [MENU_FORMAT_SFT_D]      = MENU_LIST(gSubMenu_SFT_D),
+    [MENU_FORMAT_W_N]        = MENU_LIST(gSubMenu_W_N),
+    [MENU_FORMAT_RX_TX]      = MENU_LIST(gSubMenu_RX_TX),
+#ifdef ENABLE_VOICE
+    [MENU_FORMAT_VOICE]      = MENU_LIST(gSubMenu_VOICE),
+#endif
+#ifdef ENABLE_ALARM
+    [MENU_FORMAT_AL_MOD]     = MENU_LIST(gSubMenu_AL_MOD),
+#endif
+#ifdef ENABLE_DTMF_CALLING
+    [MENU_FORMAT_D_RSP]      = MENU_LIST(gSubMenu_D_RSP),
+#endif
+    [MENU_FORMAT_PONMSG]     = MENU_LIST(gSubMenu_PONMSG),
+    [MENU_FORMAT_ROGER]      = MENU_LIST(gSubMenu_ROGER),
+    [MENU_FORMAT_BAT_TXT]    = MENU_LIST(gSubMenu_BAT_TXT),
+    [MENU_FORMAT_RESET]      = MENU_LIST(gSubMenu_RESET),
+    [MENU_FORMAT_BATTYP]     = MENU_LIST(gSubMenu_BATTYP),
+#ifdef ENABLE_CW
+    [MENU_FORMAT_CW_MODE]    = MENU_LIST(gSubMenu_CW_MODE),
+    [MENU_FORMAT_CW_TX_MODE] = MENU_LIST(gSubMenu_CW_TX_Mode),
+#endif
+#ifdef ENABLE_FEAT_F4HWN
+    [MENU_FORMAT_SET_PTT]    = MENU_LIST(gSubMenu_SET_PTT),
+    [MENU_FORMAT_SET_TOT]    = MENU_LIST(gSubMenu_SET_TOT),
+    [MENU_FORMAT_SET_LCK]    = MENU_LIST(gSubMenu_SET_LCK),
+    [MENU_FORMAT_SET_MET]    = MENU_LIST(gSubMenu_SET_MET),
+    #ifdef ENABLE_FEAT_F4HWN_NARROWER
+        [MENU_FORMAT_SET_NFM] = MENU_LIST(gSubMenu_SET_NFM),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
+        [MENU_FORMAT_SET_KEY] = MENU_LIST(gSubMenu_SET_KEY),
+    #endif
+#endif
+};
+
 bool    gIsInSubMenu;
 uint8_t gMenuCursor;
 int UI_MENU_GetCurrentMenuId() {
@@ -648,12 +693,16 @@ void UI_DisplayMenu(void)
         uint8_t gaugeMax = 0;
     #endif
 
+    const uint8_t format = MENU_GetSetting(UI_MENU_GetCurrentMenuId())->format;
+
+    if (format == MENU_FORMAT_NUMBER)
+        sprintf(String, "%d", gSubMenuSelection);
+    else
+    if (format != MENU_FORMAT_CUSTOM)
+        strcpy(String, MenuFormatLists[format].strings + MenuFormatLists[format].stride * gSubMenuSelection);
+
     switch (UI_MENU_GetCurrentMenuId())
     {
-        case MENU_SQL:
-            sprintf(String, "%d", gSubMenuSelection);
-            break;
-
         case MENU_MIC:
             {   // display the mic gain in actual dB rather than just an index number
                 const uint8_t mic = gMicGain_dB2[gSubMenuSelection];
@@ -661,13 +710,11 @@ void UI_DisplayMenu(void)
             }
             break;
 
-        case MENU_MIC_BAR:
-            #ifdef ENABLE_AUDIO_BAR
-                strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
-            #else
+        #ifndef ENABLE_AUDIO_BAR
+            case MENU_MIC_BAR:
                 strcpy(String, gSubMenu_NA);
-            #endif
-            break;
+                break;
+        #endif
 
         case MENU_STEP: {
             uint16_t step = gStepFrequencyTable[FREQUENCY_GetStepIdxFromSortedIdx(gSubMenuSelection)];
@@ -706,10 +753,6 @@ void UI_DisplayMenu(void)
             break;
         }
 
-        case MENU_SFT_D:
-            strcpy(String, gSubMenu_SFT_D[gSubMenuSelection]);
-            break;
-
         case MENU_OFFSET:
             if (!gIsInSubMenu || gInputBoxIndex == 0)
             {
@@ -728,10 +771,6 @@ void UI_DisplayMenu(void)
             already_printed = true;
             break;
 
-        case MENU_W_N:
-            strcpy(String, gSubMenu_W_N[gSubMenuSelection]);
-            break;
-
 #ifndef ENABLE_FEAT_F4HWN
         case MENU_SCR:
             strcpy(String, gSubMenu_SCRAMBLER[gSubMenuSelection]);
@@ -806,45 +845,6 @@ void UI_DisplayMenu(void)
             }
             break;
 
-        case MENU_COMPAND:
-        case MENU_ABR_ON_TX_RX:
-            strcpy(String, gSubMenu_RX_TX[gSubMenuSelection]);
-            break;
-
-        #ifndef ENABLE_FEAT_F4HWN
-            #ifdef ENABLE_AM_FIX
-                case MENU_AM_FIX:
-            #endif
-        #endif
-        case MENU_BCL:
-        case MENU_BEEP:
-        case MENU_S_ADD1:
-        case MENU_S_ADD2:
-        case MENU_S_ADD3:
-        case MENU_STE:
-        case MENU_D_ST:
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-#endif
-        case MENU_D_LIVE_DEC:
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-        #endif
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-        case MENU_200TX:
-        case MENU_500TX:
-#endif
-        case MENU_350EN:
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_SCREN:
-#endif
-#ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_TMR:
-#endif
-            strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
-            break;
-
         case MENU_MEM_CH:
         case MENU_1_CALL:
         case MENU_DEL_CH:
@@ -925,12 +925,6 @@ void UI_DisplayMenu(void)
             #endif
             break;
 
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                strcpy(String, gSubMenu_VOICE[gSubMenuSelection]);
-                break;
-        #endif
-
         case MENU_SC_REV:
             if(gSubMenuSelection == 0)
             {
@@ -977,12 +971,6 @@ void UI_DisplayMenu(void)
                 strcpy(String, "ALL");
             break;
 
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                sprintf(String, gSubMenu_AL_MOD[gSubMenuSelection]);
-                break;
-        #endif
-
 #ifdef ENABLE_DTMF_CALLING
         case MENU_ANI_ID:
             strcpy(String, gEeprom.ANI_DTMF_ID);
@@ -997,10 +985,6 @@ void UI_DisplayMenu(void)
             break;
 
 #ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            strcpy(String, gSubMenu_D_RSP[gSubMenuSelection]);
-            break;
-
         case MENU_D_HOLD:
             sprintf(String, "%ds", gSubMenuSelection);
             break;
@@ -1013,10 +997,6 @@ void UI_DisplayMenu(void)
             strcpy(String, gSubMenu_PTT_ID[gSubMenuSelection]);
             break;
 
-        case MENU_BAT_TXT:
-            strcpy(String, gSubMenu_BAT_TXT[gSubMenuSelection]);
-            break;
-
 #ifdef ENABLE_DTMF_CALLING
         case MENU_D_LIST:
             gIsDtmfContactValid = DTMF_GetContact((int)gSubMenuSelection - 1, Contact);
@@ -1027,14 +1007,6 @@ void UI_DisplayMenu(void)
             break;
 #endif
 
-        case MENU_PONMSG:
-            strcpy(String, gSubMenu_PONMSG[gSubMenuSelection]);
-            break;
-
-        case MENU_ROGER:
-            strcpy(String, gSubMenu_ROGER[gSubMenuSelection]);
-            break;
-
         case MENU_VOL:
 #ifdef ENABLE_FEAT_F4HWN
             sprintf(String, "%s\n%s",
@@ -1049,18 +1021,12 @@ void UI_DisplayMenu(void)
             break;
 
 #ifdef ENABLE_CW
-        case MENU_CW_ENABLED:
-            strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
-            break;
         case MENU_CW_WPM:
             sprintf(String, "%d WPM", gSubMenuSelection);
             break;
         case MENU_CW_TONE:
             sprintf(String, "%d Hz", gSubMenuSelection);
             break;
-        case MENU_CW_MODE:
-            strcpy(String, gSubMenu_CW_MODE[gSubMenuSelection]);
-            break;
         case MENU_CW_MSG1:
         case MENU_CW_MSG2:
             {
@@ -1084,14 +1050,6 @@ void UI_DisplayMenu(void)
             }
             break;
 
-        case MENU_CW_FMCW:
-            strcpy(String, gSubMenu_CW_TX_Mode[gSubMenuSelection]);
-            break;
-
-        case MENU_CW_WN:
-            strcpy(String, gSubMenu_W_N[gSubMenuSelection]);
-            break;
-
         case MENU_CW_ID:
         case MENU_CW_GRID:
             {
@@ -1115,11 +1073,6 @@ void UI_DisplayMenu(void)
             }
             break;
 
-        case MENU_CW_EOT:
-        case MENU_CW_T_HUNT:
-            strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
-            break;
-
         case MENU_CW_SOS:
 #ifdef ENABLE_SOS
             if (!gIsInSubMenu) {
@@ -1135,10 +1088,6 @@ void UI_DisplayMenu(void)
 #endif
             break;
 
-        case MENU_CW_PIP_CNT:
-            sprintf(String, "%d", gSubMenuSelection);
-            break;
-
         case MENU_CW_PIP_INT:
             sprintf(String, "%ds", gSubMenuSelection);
             break;
@@ -1148,10 +1097,6 @@ void UI_DisplayMenu(void)
             break;
 #endif
 
-        case MENU_RESET:
-            strcpy(String, gSubMenu_RESET[gSubMenuSelection]);
-            break;
-
         case MENU_F_LOCK:
 #ifdef ENABLE_FEAT_F4HWN
             if(!gIsInSubMenu && gUnlockAllTxConfCnt>0 && gUnlockAllTxConfCnt<3)
@@ -1185,10 +1130,6 @@ void UI_DisplayMenu(void)
             break;
         }
 
-        case MENU_BATTYP:
-            strcpy(String, gSubMenu_BATTYP[gSubMenuSelection]);
-            break;
-
         case MENU_F1SHRT:
         case MENU_F1LONG:
         case MENU_F2SHRT:
@@ -1221,15 +1162,6 @@ void UI_DisplayMenu(void)
             sprintf(String, "%s\n%sW", gSubMenu_TXP[gSubMenuSelection + 1], gSubMenu_SET_PWR[gSubMenuSelection]);
             break;
     
-        case MENU_SET_PTT:
-            strcpy(String, gSubMenu_SET_PTT[gSubMenuSelection]);
-            break;
-
-        case MENU_SET_TOT:
-        case MENU_SET_EOT:
-            strcpy(String, gSubMenu_SET_TOT[gSubMenuSelection]); // Same as SET_TOT
-            break;
-
         case MENU_SET_CTR:
             #ifdef ENABLE_FEAT_F4HWN_CTR
                 sprintf(String, "%d", gSubMenuSelection);
@@ -1260,21 +1192,6 @@ void UI_DisplayMenu(void)
             }
             break;
 
-        case MENU_SET_LCK:
-            strcpy(String, gSubMenu_SET_LCK[gSubMenuSelection]);
-            break;
-
-        case MENU_SET_MET:
-        case MENU_SET_GUI:
-            strcpy(String, gSubMenu_SET_MET[gSubMenuSelection]); // Same as SET_MET
-            break;
-
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                strcpy(String, gSubMenu_SET_NFM[gSubMenuSelection]);
-                break;
-        #endif
-
         #ifdef ENABLE_FEAT_F4HWN_VOL
             case MENU_SET_VOL:
                 if(gSubMenuSelection == 0)
@@ -1299,12 +1216,6 @@ void UI_DisplayMenu(void)
                     (gEeprom.DAC_GAIN    << 0));     // AF DAC Gain (after Gain-1 and Gain-2)
                 break;
         #endif
-
-        #ifdef ENABLE_FEAT_F4HWN_RESCUE_OPS
-            case MENU_SET_KEY:
-                strcpy(String, gSubMenu_SET_KEY[gSubMenuSelection]);
-                break;                
-        #endif
 #endif
 
     }
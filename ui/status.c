@@ -272,6 +272,15 @@ void UI_DisplayStatus()
             //gBatteryVoltageAverage = 999;
             sprintf(str, "%02u%%", BATTERY_VoltsToPercent(gBatteryVoltageAverage));
             break;
+
+        case 3: {   // predicted runtime
+            const uint16_t minutes = BATTERY_RemainingMinutes();
+            if (minutes == 0)
+                strcpy(str, "-:--");
+            else
+                sprintf(str, "%u:%02u", MIN(minutes / 60, 99), minutes % 60);
+            break;
+        }
     }
 
     if (BatTxt) {
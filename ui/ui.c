@@ -33,6 +33,7 @@
 #ifdef ENABLE_REGA
     #include "app/rega.h"
 #endif
+#include "ui/helper.h"
 #include "ui/inputbox.h"
 #include "ui/main.h"
 #include "ui/menu.h"
@@ -83,6 +84,7 @@ void GUI_SelectNextDisplay(GUI_DisplayType_t Display)
     if (gScreenToDisplay != Display)
     {
         DTMF_clear_input_box();
+        UI_PopupDiscard();
 
         gInputBoxIndex       = 0;
         gIsInSubMenu         = false;
@@ -110,6 +110,11 @@
 #4.2.0:
 #       add support for k5 viewer feature
 
+#4.2.1:
+#       download and upload only the 64 byte blocks whose CRC differs
+#       (UART command 0x0537), against the last image kept in the CHIRP
+#       config dir, full transfer with firmware that does not answer it
+
 import webbrowser
 import os
 
@@ -136,7 +141,7 @@ DEBUG_SHOW_OBFUSCATED_COMMANDS = False
 DEBUG_SHOW_MEMORY_ACTIONS = False
 
 # TODO: remove the driver version when it's in mainline chirp 
-DRIVER_VERSION = "Quansheng UV-K5/K6/5R driver ver: 2025/08/07 (c) EGZUMER + F4HWN v4.2.0"
+DRIVER_VERSION = "Quansheng UV-K5/K6/5R driver ver: 2026/10/19 (c) EGZUMER + F4HWN v4.2.1"
 FIRMWARE_VERSION_UPDATE = "https://github.com/armel/uv-k5-firmware-custom/releases"
 
 CHIRP_DRIVER_VERSION_UPDATE = "https://github.com/armel/uv-k5-chirp-driver/releases"
@@ -580,7 +585,7 @@ BATSAVE_LIST = ["OFF", "1:1", "1:2", "1:3", "1:4", "1:5"]
 # battery type
 BATTYPE_LIST = ["1600 mAh", "2200 mAh", "3500 mAh"]
 # bat txt
-BAT_TXT_LIST = ["NONE", "VOLTAGE", "PERCENT"]
+BAT_TXT_LIST = ["NONE", "VOLTAGE", "PERCENT", "RUNTIME"]
 # Backlight auto mode
 BACKLIGHT_LIST = ["OFF", "5 sec", "10 sec", "15 sec", "20 sec", "25 sec", "30 sec", "35 sec", "40 sec", "45 sec", "50 sec", "55 sec", 
                   "1 min", "1 min : 5 sec", "1 min : 10 sec", "1 min : 15 sec", "1 min : 20 sec", "1 min : 25 sec", "1 min : 30 sec", "1 min : 35 sec", "1 min : 40 sec", "1 min : 45 sec", "1 min : 50 sec", "1 min : 55 sec", 
@@ -675,6 +680,9 @@ VOX_LIST = ["OFF", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10"]
 MEM_SIZE = 0x2000 # size of all memory
 PROG_SIZE = 0x1d00  # size of the memory that we will write
 MEM_BLOCK = 0x80  # largest block of memory that we can reliably write
+MANIFEST_BLOCK = 0x40  # block size of the CRC manifest, command 0x0537
+MANIFEST_COUNT = 64  # most CRCs in one manifest reply
+CACHE_FILE = "uvk5_egzumer_eeprom.img"  # last image seen, in the CHIRP config dir
 CAL_START = 0x1E00  # calibration memory start address
 F4HWN_START =0x1FF2 # calibration F4HWN memory start address
 
@@ -907,6 +915,65 @@ def _writemem(serport, data, offset):
     raise errors.RadioError("Bad response to writemem")
 
 
+def _readmanifest(serport, offset, length):
+    """CRC16 of each MANIFEST_BLOCK of the range, the last one may run past
+    it. None if the firmware does not know the command"""
+    total = -(-length // MANIFEST_BLOCK)
+    crcs = []
+    while len(crcs) < total:
+        count = min(MANIFEST_COUNT, total - len(crcs))
+        LOG.debug("Sending manifest offset=0x%4.4x count=%i", offset, count)
+
+        manifest = b"\x37\x05\x08\x00" + \
+            struct.pack("<HBB", offset, MANIFEST_BLOCK, count) + \
+            b"\x6a\x39\x57\x64"
+        _send_command(serport, manifest)
+        try:
+            rep = _receive_reply(serport)
+        except errors.RadioError:
+            LOG.info("No CRC manifest from this firmware, full transfer")
+            return None
+
+        if len(rep) < 8 + count * 2 or rep[0] != 0x38 or rep[7] != count:
+            LOG.info("Bad CRC manifest reply, full transfer")
+            return None
+
+        crcs += struct.unpack_from("<%iH" % count, rep, 8)
+        offset += count * MANIFEST_BLOCK
+    return crcs
+
+
+def _cache_path():
+    try:
+        from chirp import platform
+        return platform.get_platform().config_file(CACHE_FILE)
+    except Exception:
+        return None
+
+
+def _load_cache():
+    path = _cache_path()
+    if not path:
+        return None
+    try:
+        with open(path, "rb") as f:
+            data = f.read()
+    except OSError:
+        return None
+    return data if len(data) == MEM_SIZE else None
+
+
+def _save_cache(data):
+    path = _cache_path()
+    if not path or len(data) != MEM_SIZE:
+        return
+    try:
+        with open(path, "wb") as f:
+            f.write(data)
+    except OSError as e:
+        LOG.warning("Could not write the EEPROM cache: %s", e)
+
+
 def _resetradio(serport):
     resetpacket = b"\xdd\x05\x00\x00"
     _send_command(serport, resetpacket)
@@ -929,18 +996,36 @@ def do_download(radio):
     else:
         raise errors.RadioError("Failed to initialize radio")
 
+    # with an image from an earlier session only the blocks whose CRC
+    # differs on the radio are read
+    cache = _load_cache()
+    crcs = _readmanifest(serport, 0, MEM_SIZE) if cache else None
+
     addr = 0
     while addr < MEM_SIZE:
-        data = _readmem(serport, addr, MEM_BLOCK)
         status.cur = addr
         radio.status_fn(status)
 
-        if data and len(data) == MEM_BLOCK:
+        if crcs is not None:
+            length = MANIFEST_BLOCK
+            data = cache[addr:addr+length]
+            if calculate_crc16_xmodem(data) == crcs[addr // length]:
+                eeprom += data
+                addr += length
+                continue
+        else:
+            length = MEM_BLOCK
+
+        data = _readmem(serport, addr, length)
+
+        if data and len(data) == length:
             eeprom += data
-            addr += MEM_BLOCK
+            addr += length
         else:
             raise errors.RadioError("Memory download incomplete")
 
+    _save_cache(eeprom)
+
     return memmap.MemoryMapBytes(eeprom)
 
 
@@ -974,14 +1059,20 @@ def do_upload(radio):
  
     while mstep < 2: # stop when 2
         
+        # only the blocks whose CRC differs on the radio are written
+        crcs = _readmanifest(serport, start_addr, stop_addr - start_addr)
+        step = MANIFEST_BLOCK if crcs is not None else MEM_BLOCK
+
         addr = start_addr
         while addr < stop_addr:
-            dat = radio.get_mmap()[addr:addr+MEM_BLOCK]
-            _writemem(serport, dat, addr)
+            dat = radio.get_mmap()[addr:addr+step]
+            if crcs is None or \
+               calculate_crc16_xmodem(dat) != crcs[(addr - start_addr) // step]:
+                _writemem(serport, dat, addr)
             status.cur = addr - start_addr
             radio.status_fn(status)
             if dat:
-                addr += MEM_BLOCK
+                addr += step
             else:
                 raise errors.RadioError("Memory upload incomplete")
                 mstep = 2 # on error stop loop
@@ -995,6 +1086,8 @@ def do_upload(radio):
 
     status.msg = "Uploaded OK"
 
+    _save_cache(radio.get_mmap()[0:MEM_SIZE])
+
     _resetradio(serport)
 
     return True
@@ -2497,6 +2590,7 @@ class UVK5RadioEgzumer(chirp_common.CloneModeRadio):
         val = RadioSettingValueList(BAT_TXT_LIST, None, tmpbattxt)
         bat_txt_setting = RadioSetting("battery_text", "Battery Level Display (BatTXT)", val)
         bat_txt_setting.set_doc('BatTXT: Display additional battery info on the status bar\n' + \
+                                '* RUNTIME : Predicted hours:minutes left\n' + \
                                 '* PERCENT : Percentage of remaining power\n' + \
                                 '* VOLTAGE : Voltage\n' + \
                                 '* NONE : Nothing')